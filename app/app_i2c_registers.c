@@ -2,6 +2,7 @@
 
 static const uint8_t g_app_i2c_hw_version[] = APP_I2C_HW_VERSION_BYTES;
 static const uint8_t g_app_i2c_sw_version[] = APP_I2C_SW_VERSION_BYTES;
+static uint8_t g_app_i2c_starvation[APP_I2C_STARVATION_LENGTH];
 
 const app_i2c_command_descriptor_t g_app_i2c_commands[] =
 {
@@ -16,6 +17,12 @@ const app_i2c_command_descriptor_t g_app_i2c_commands[] =
         g_app_i2c_sw_version,
         (uint8_t)(sizeof g_app_i2c_sw_version),
         NULL
+    },
+    {
+        APP_I2C_REG_ADDR_STARVATION,
+        g_app_i2c_starvation,
+        (uint8_t)(sizeof g_app_i2c_starvation),
+        NULL
     }
 };
 
@@ -35,4 +42,19 @@ const app_i2c_command_descriptor_t *APP_I2C_FindCommand(uint8_t reg_address)
     }
 
     return entry;
-}
\ No newline at end of file
+}
+static void app_i2c_put_u32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)(value >> 24);
+    buffer[1] = (uint8_t)(value >> 16);
+    buffer[2] = (uint8_t)(value >> 8);
+    buffer[3] = (uint8_t)value;
+}
+
+void APP_I2C_SetStarvationReport(uint8_t task_index, uint32_t uptime_ms, uint32_t silent_ticks)
+{
+    g_app_i2c_starvation[0] = 1U;
+    g_app_i2c_starvation[1] = task_index;
+    app_i2c_put_u32(&g_app_i2c_starvation[2], uptime_ms);
+    app_i2c_put_u32(&g_app_i2c_starvation[6], silent_ticks);
+}
@@ -0,0 +1,875 @@
+#include "app_kv_store.h"
+#include "r_cg_macrodriver.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/* A full boot scan can outlast the watchdog period; kept alive per record */
+#ifndef APP_KV_SCAN_SERVICE
+#define APP_KV_SCAN_SERVICE()  ((void)R_WDT_Restart())
+#endif
+
+#if (APP_KV_RECORD_SIZE < 12U) || (APP_KV_RECORD_SIZE > 255U)
+#error "APP_KV_RECORD_SIZE must be between 12 and 255 bytes"
+#endif
+
+#define APP_KV_OFFSET_KEY        (0U)
+#define APP_KV_OFFSET_LENGTH     (1U)
+#define APP_KV_OFFSET_SEQUENCE   (2U)
+#define APP_KV_OFFSET_VALUE      (6U)
+#define APP_KV_OFFSET_CRC        (APP_KV_RECORD_SIZE - 2U)
+
+/* Set in the length byte of a delete record */
+#define APP_KV_LENGTH_DELETED    (0x80U)
+
+/* Slot 0 of each bank holds its header; data records follow from slot 1 */
+#define APP_KV_HEADER_SLOT       (0U)
+
+/* Checkpoint copy layout; the CRC covers everything after it */
+#define APP_KV_CP_OFFSET_GENERATION   (0U)
+#define APP_KV_CP_OFFSET_CRC          (4U)
+#define APP_KV_CP_OFFSET_BANK         (6U)
+#define APP_KV_CP_OFFSET_KEYS         (7U)
+#define APP_KV_CP_OFFSET_HEADER_SEQ   (8U)
+#define APP_KV_CP_OFFSET_SEQUENCE     (12U)
+#define APP_KV_CP_OFFSET_HEAD         (16U)
+#define APP_KV_CP_OFFSET_ENTRIES      (18U)
+#define APP_KV_CP_ENTRY_SIZE          (2U + APP_KV_VALUE_MAX)
+#define APP_KV_CP_COPIES              (2U)
+
+typedef struct
+{
+    uint8_t  key;
+    uint8_t  length;     /* value bytes, APP_KV_LENGTH_DELETED for a delete */
+    uint32_t sequence;
+    const uint8_t *value;
+} app_kv_record_t;
+
+typedef struct
+{
+    bool    used;
+    uint8_t key;
+    uint8_t length;
+    uint8_t value[APP_KV_VALUE_MAX];
+} app_kv_entry_t;
+
+typedef struct
+{
+    const hal_i2c_m_eeprom_t *device;
+    uint32_t       base_address;
+    uint16_t       bank_records;
+    uint16_t       head;           /* next free slot in the active bank */
+    uint8_t        active_bank;
+    uint32_t       header_sequence; /* sequence of the active bank's header */
+    uint32_t       sequence;
+    uint32_t       cp_generation;  /* newest checkpoint generation seen */
+    uint8_t        cp_copy;        /* copy the next checkpoint overwrites */
+    uint16_t       cp_appends;     /* appends since the last checkpoint */
+    uint16_t       cp_interval;    /* APP_KV_CHECKPOINT_INTERVAL, at least one bank */
+    bool           cp_pending;     /* cp_buffer handed to the background writer */
+    hal_i2c_m_eeprom_status_t cp_status; /* outcome reported by its callback */
+    uint8_t        cp_buffer[APP_KV_CHECKPOINT_SIZE];
+    app_kv_entry_t entries[APP_KV_MAX_KEYS];
+    app_kv_stats_t stats;
+} app_kv_store_t;
+
+/* Boot scan of one bank, fed record by record from the streaming read */
+typedef struct
+{
+    uint16_t slot;
+    uint32_t first_sequence;   /* records below this belong to an older bank life */
+    uint32_t max_sequence;
+    uint16_t next_head;
+} app_kv_scan_t;
+
+static app_kv_store_t g_app_kv_store;
+
+static uint16_t app_kv_crc16(const uint8_t *data, uint16_t length)
+{
+    uint16_t crc = 0xFFFFU;
+
+    /* CRC-16/CCITT-FALSE; all-0x00 and all-0xFF slots never check */
+    for (uint16_t index = 0U; index < length; index++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[index] << 8);
+        for (uint8_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static void app_kv_put_u32(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t app_kv_get_u32(const uint8_t *data)
+{
+    return (uint32_t)data[0] |
+           ((uint32_t)data[1] << 8) |
+           ((uint32_t)data[2] << 16) |
+           ((uint32_t)data[3] << 24);
+}
+
+static void app_kv_encode(uint8_t *record, const app_kv_record_t *content, uint8_t value_length)
+{
+    (void)memset(record, 0xFF, APP_KV_RECORD_SIZE);
+    record[APP_KV_OFFSET_KEY]    = content->key;
+    record[APP_KV_OFFSET_LENGTH] = content->length;
+    app_kv_put_u32(&record[APP_KV_OFFSET_SEQUENCE], content->sequence);
+    if (value_length > 0U)
+    {
+        (void)memcpy(&record[APP_KV_OFFSET_VALUE], content->value, value_length);
+    }
+
+    const uint16_t crc = app_kv_crc16(record, APP_KV_OFFSET_CRC);
+
+    record[APP_KV_OFFSET_CRC]      = (uint8_t)crc;
+    record[APP_KV_OFFSET_CRC + 1U] = (uint8_t)(crc >> 8);
+}
+
+static bool app_kv_decode(const uint8_t *record, app_kv_record_t *content)
+{
+    const uint16_t stored = (uint16_t)record[APP_KV_OFFSET_CRC] |
+                            (uint16_t)((uint16_t)record[APP_KV_OFFSET_CRC + 1U] << 8);
+
+    if (stored != app_kv_crc16(record, APP_KV_OFFSET_CRC))
+    {
+        return false;
+    }
+
+    content->key      = record[APP_KV_OFFSET_KEY];
+    content->length   = record[APP_KV_OFFSET_LENGTH];
+    content->sequence = app_kv_get_u32(&record[APP_KV_OFFSET_SEQUENCE]);
+    content->value    = &record[APP_KV_OFFSET_VALUE];
+
+    return ((content->length & (uint8_t)~APP_KV_LENGTH_DELETED) <= APP_KV_VALUE_MAX);
+}
+
+static uint32_t app_kv_slot_address(uint8_t bank, uint16_t slot)
+{
+    const app_kv_store_t *store = &g_app_kv_store;
+
+    return store->base_address + (APP_KV_CP_COPIES * APP_KV_CHECKPOINT_SIZE) +
+           ((((uint32_t)bank * store->bank_records) + slot) * APP_KV_RECORD_SIZE);
+}
+
+static uint32_t app_kv_checkpoint_address(uint8_t copy)
+{
+    return g_app_kv_store.base_address + ((uint32_t)copy * APP_KV_CHECKPOINT_SIZE);
+}
+
+static void app_kv_checkpoint_done(bool success, void *context)
+{
+    app_kv_store_t *store = (app_kv_store_t *)context;
+
+    store->cp_status = success ? HAL_I2C_M_EEPROM_DONE : HAL_I2C_M_EEPROM_FAILED;
+}
+
+/*
+ * Retire a background checkpoint once the writer has finished with it. With
+ * wait set a page still in its write cycle is waited out, so a blocking
+ * access can follow.
+ */
+static void app_kv_poll_checkpoint(bool wait)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+
+    if (!store->cp_pending)
+    {
+        return;
+    }
+
+    if (store->cp_status == HAL_I2C_M_EEPROM_BUSY)
+    {
+        if (wait)
+        {
+            (void)HAL_I2C_M_EEPROM_WaitReady(store->device);
+        }
+        return;
+    }
+
+    store->cp_pending = false;
+
+    if (store->cp_status == HAL_I2C_M_EEPROM_DONE)
+    {
+        store->cp_generation++;
+        store->cp_copy = (uint8_t)(store->cp_copy ^ 1U);
+        store->stats.checkpoints++;
+    }
+    else
+    {
+        /* A torn copy fails its CRC; the next append rewrites the same one */
+        store->cp_appends = store->cp_interval;
+    }
+}
+
+static bool app_kv_write_slot(uint8_t bank, uint16_t slot, const app_kv_record_t *content, uint8_t value_length)
+{
+    uint8_t record[APP_KV_RECORD_SIZE];
+
+    app_kv_poll_checkpoint(true);
+    app_kv_encode(record, content, value_length);
+    g_app_kv_store.stats.appends++;
+
+    return HAL_I2C_M_EEPROM_Write(g_app_kv_store.device, app_kv_slot_address(bank, slot), record, APP_KV_RECORD_SIZE);
+}
+
+static bool app_kv_read_header(uint8_t bank, uint32_t *header_sequence, uint32_t *first_sequence)
+{
+    uint8_t record[APP_KV_RECORD_SIZE];
+    app_kv_record_t content;
+
+    if (!HAL_I2C_M_EEPROM_Read(g_app_kv_store.device, app_kv_slot_address(bank, APP_KV_HEADER_SLOT),
+                               record, APP_KV_RECORD_SIZE) ||
+        !app_kv_decode(record, &content) ||
+        (content.key != APP_KV_KEY_INVALID))
+    {
+        return false;
+    }
+
+    *header_sequence = content.sequence;
+    *first_sequence  = app_kv_get_u32(content.value);
+
+    return true;
+}
+
+static bool app_kv_write_header(uint8_t bank, uint32_t first_sequence)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    uint8_t value[4];
+    app_kv_record_t header;
+
+    app_kv_put_u32(value, first_sequence);
+    header.key      = APP_KV_KEY_INVALID;
+    header.length   = 0U;
+    header.sequence = store->sequence++;
+    header.value    = value;
+
+    if (!app_kv_write_slot(bank, APP_KV_HEADER_SLOT, &header, (uint8_t)sizeof value))
+    {
+        return false;
+    }
+
+    store->active_bank     = bank;
+    store->header_sequence = header.sequence;
+
+    return true;
+}
+
+static app_kv_entry_t *app_kv_find(uint8_t key)
+{
+    for (uint8_t index = 0U; index < APP_KV_MAX_KEYS; index++)
+    {
+        app_kv_entry_t *entry = &g_app_kv_store.entries[index];
+
+        if (entry->used && (entry->key == key))
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static app_kv_entry_t *app_kv_find_free(void)
+{
+    for (uint8_t index = 0U; index < APP_KV_MAX_KEYS; index++)
+    {
+        app_kv_entry_t *entry = &g_app_kv_store.entries[index];
+
+        if (!entry->used)
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static void app_kv_apply(const app_kv_record_t *content)
+{
+    app_kv_entry_t *entry = app_kv_find(content->key);
+
+    if ((content->length & APP_KV_LENGTH_DELETED) != 0U)
+    {
+        if (entry != NULL)
+        {
+            entry->used = false;
+        }
+        return;
+    }
+
+    if (entry == NULL)
+    {
+        entry = app_kv_find_free();
+        if (entry == NULL)
+        {
+            /* Written by a build with a larger index; nothing to keep it in */
+            return;
+        }
+    }
+
+    entry->used   = true;
+    entry->key    = content->key;
+    entry->length = content->length;
+    if (content->length > 0U)
+    {
+        (void)memcpy(entry->value, content->value, content->length);
+    }
+}
+
+static bool app_kv_scan_record(const uint8_t *data, uint16_t length, void *context)
+{
+    app_kv_scan_t *scan = (app_kv_scan_t *)context;
+    app_kv_record_t content;
+
+    if ((length == APP_KV_RECORD_SIZE) && app_kv_decode(data, &content))
+    {
+        if (content.sequence > scan->max_sequence)
+        {
+            scan->max_sequence = content.sequence;
+        }
+
+        /* Records are appended in slot order, so later slots win */
+        if ((scan->slot != APP_KV_HEADER_SLOT) &&
+            (content.key != APP_KV_KEY_INVALID) &&
+            (content.sequence >= scan->first_sequence))
+        {
+            app_kv_apply(&content);
+            scan->next_head = (uint16_t)(scan->slot + 1U);
+        }
+    }
+
+    scan->slot++;
+    APP_KV_SCAN_SERVICE();
+
+    return true;
+}
+
+static bool app_kv_scan_bank(uint8_t bank, app_kv_scan_t *scan)
+{
+    uint8_t chunk[APP_KV_RECORD_SIZE];
+    const app_kv_store_t *store = &g_app_kv_store;
+
+    scan->slot      = 0U;
+    scan->next_head = 1U;
+
+    return HAL_I2C_M_EEPROM_ReadStream(store->device,
+                                       app_kv_slot_address(bank, 0U),
+                                       (uint32_t)store->bank_records * APP_KV_RECORD_SIZE,
+                                       chunk,
+                                       (uint16_t)sizeof chunk,
+                                       app_kv_scan_record,
+                                       scan);
+}
+
+static uint8_t app_kv_live_count(void)
+{
+    uint8_t count = 0U;
+
+    for (uint8_t index = 0U; index < APP_KV_MAX_KEYS; index++)
+    {
+        if (g_app_kv_store.entries[index].used)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * Write the index to the older checkpoint copy; the newer one stays intact.
+ * Without blocking the copy is handed to the background writer and counts
+ * once app_kv_poll_checkpoint sees it finished. False while the previous
+ * background copy is still being written.
+ */
+static bool app_kv_checkpoint(bool blocking)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    uint8_t *block = store->cp_buffer;
+    uint8_t keys = 0U;
+
+    app_kv_poll_checkpoint(false);
+    if (store->cp_pending)
+    {
+        return false;
+    }
+
+    (void)memset(block, 0xFF, APP_KV_CHECKPOINT_SIZE);
+
+    for (uint8_t index = 0U; index < APP_KV_MAX_KEYS; index++)
+    {
+        const app_kv_entry_t *entry = &store->entries[index];
+        uint8_t *slot = &block[APP_KV_CP_OFFSET_ENTRIES + ((uint16_t)keys * APP_KV_CP_ENTRY_SIZE)];
+
+        if (!entry->used)
+        {
+            continue;
+        }
+
+        slot[0] = entry->key;
+        slot[1] = entry->length;
+        (void)memcpy(&slot[2], entry->value, entry->length);
+        keys++;
+    }
+
+    app_kv_put_u32(&block[APP_KV_CP_OFFSET_GENERATION], store->cp_generation + 1UL);
+    block[APP_KV_CP_OFFSET_BANK] = store->active_bank;
+    block[APP_KV_CP_OFFSET_KEYS] = keys;
+    app_kv_put_u32(&block[APP_KV_CP_OFFSET_HEADER_SEQ], store->header_sequence);
+    app_kv_put_u32(&block[APP_KV_CP_OFFSET_SEQUENCE], store->sequence);
+    block[APP_KV_CP_OFFSET_HEAD]      = (uint8_t)store->head;
+    block[APP_KV_CP_OFFSET_HEAD + 1U] = (uint8_t)(store->head >> 8);
+
+    const uint16_t crc = app_kv_crc16(&block[APP_KV_CP_OFFSET_BANK],
+                                      (uint16_t)(APP_KV_CHECKPOINT_SIZE - APP_KV_CP_OFFSET_BANK));
+
+    block[APP_KV_CP_OFFSET_CRC]      = (uint8_t)crc;
+    block[APP_KV_CP_OFFSET_CRC + 1U] = (uint8_t)(crc >> 8);
+
+    if (!blocking)
+    {
+        /* Twelve page programs would hold the bus too long for the slave side */
+        if (!HAL_I2C_M_EEPROM_WriteAsync(store->device, app_kv_checkpoint_address(store->cp_copy),
+                                         block, (uint16_t)APP_KV_CHECKPOINT_SIZE,
+                                         app_kv_checkpoint_done, store))
+        {
+            return false;
+        }
+
+        store->cp_pending = true;
+        store->cp_status  = HAL_I2C_M_EEPROM_BUSY;
+        store->cp_appends = 0U;
+
+        return true;
+    }
+
+    if (!HAL_I2C_M_EEPROM_Write(store->device, app_kv_checkpoint_address(store->cp_copy),
+                                block, (uint16_t)APP_KV_CHECKPOINT_SIZE))
+    {
+        /* A torn copy fails its CRC; the next attempt rewrites the same one */
+        return false;
+    }
+
+    store->cp_generation++;
+    store->cp_copy    = (uint8_t)(store->cp_copy ^ 1U);
+    store->cp_appends = 0U;
+    store->stats.checkpoints++;
+
+    return true;
+}
+
+/*
+ * Restore the index from one checkpoint copy and replay the records appended
+ * after it. False when the copy is torn or a compaction has run since.
+ */
+static bool app_kv_restore_checkpoint(uint8_t copy)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    const uint8_t *block = store->cp_buffer;
+
+    if (!HAL_I2C_M_EEPROM_Read(store->device, app_kv_checkpoint_address(copy),
+                               store->cp_buffer, (uint16_t)APP_KV_CHECKPOINT_SIZE))
+    {
+        return false;
+    }
+
+    const uint16_t stored = (uint16_t)block[APP_KV_CP_OFFSET_CRC] |
+                            (uint16_t)((uint16_t)block[APP_KV_CP_OFFSET_CRC + 1U] << 8);
+    const uint8_t bank = block[APP_KV_CP_OFFSET_BANK];
+    const uint8_t keys = block[APP_KV_CP_OFFSET_KEYS];
+    const uint32_t checkpoint_header = app_kv_get_u32(&block[APP_KV_CP_OFFSET_HEADER_SEQ]);
+    const uint32_t checkpoint_sequence = app_kv_get_u32(&block[APP_KV_CP_OFFSET_SEQUENCE]);
+    const uint16_t head = (uint16_t)block[APP_KV_CP_OFFSET_HEAD] |
+                          (uint16_t)((uint16_t)block[APP_KV_CP_OFFSET_HEAD + 1U] << 8);
+
+    if ((stored != app_kv_crc16(&block[APP_KV_CP_OFFSET_BANK],
+                                (uint16_t)(APP_KV_CHECKPOINT_SIZE - APP_KV_CP_OFFSET_BANK))) ||
+        (bank > 1U) || (keys > APP_KV_MAX_KEYS) ||
+        (head <= APP_KV_HEADER_SLOT) || (head > store->bank_records))
+    {
+        return false;
+    }
+
+    /* The bank must still carry the header it had, and the other none newer */
+    uint32_t header_sequence = 0UL;
+    uint32_t first_sequence = 0UL;
+
+    if (!app_kv_read_header(bank, &header_sequence, &first_sequence) ||
+        (header_sequence != checkpoint_header) ||
+        (app_kv_read_header((uint8_t)(bank ^ 1U), &header_sequence, &first_sequence) &&
+         (header_sequence > checkpoint_header)))
+    {
+        return false;
+    }
+
+    (void)memset(store->entries, 0, sizeof store->entries);
+
+    for (uint8_t index = 0U; index < keys; index++)
+    {
+        const uint8_t *slot = &block[APP_KV_CP_OFFSET_ENTRIES + ((uint16_t)index * APP_KV_CP_ENTRY_SIZE)];
+        app_kv_entry_t *entry = &store->entries[index];
+
+        if ((slot[0] == APP_KV_KEY_INVALID) || (slot[1] > APP_KV_VALUE_MAX))
+        {
+            return false;
+        }
+
+        entry->used   = true;
+        entry->key    = slot[0];
+        entry->length = slot[1];
+        (void)memcpy(entry->value, &slot[2], slot[1]);
+    }
+
+    store->active_bank     = bank;
+    store->header_sequence = checkpoint_header;
+    store->head            = head;
+
+    /* Appends since the checkpoint sit contiguously from its head */
+    uint32_t max_sequence = checkpoint_sequence;
+
+    while (store->head < store->bank_records)
+    {
+        uint8_t record[APP_KV_RECORD_SIZE];
+        app_kv_record_t content;
+
+        if (!HAL_I2C_M_EEPROM_Read(store->device, app_kv_slot_address(bank, store->head),
+                                   record, APP_KV_RECORD_SIZE))
+        {
+            return false;
+        }
+
+        if (!app_kv_decode(record, &content) ||
+            (content.key == APP_KV_KEY_INVALID) ||
+            (content.sequence < checkpoint_sequence))
+        {
+            break;
+        }
+
+        app_kv_apply(&content);
+        max_sequence = content.sequence;
+        store->head++;
+        store->cp_appends++;
+    }
+
+    /* Same margin over stray compaction copies as after a full scan */
+    store->sequence = max_sequence + 1UL + APP_KV_MAX_KEYS;
+
+    return true;
+}
+
+static bool app_kv_load_checkpoint(void)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    uint8_t header[APP_KV_CP_OFFSET_CRC];
+    uint32_t generation[APP_KV_CP_COPIES] = { 0UL, 0UL };
+    bool readable[APP_KV_CP_COPIES] = { false, false };
+
+    for (uint8_t copy = 0U; copy < APP_KV_CP_COPIES; copy++)
+    {
+        readable[copy] = HAL_I2C_M_EEPROM_Read(store->device, app_kv_checkpoint_address(copy),
+                                               header, (uint16_t)sizeof header);
+        generation[copy] = app_kv_get_u32(header);
+    }
+
+    const uint8_t newest = (readable[1] && (!readable[0] || (generation[1] > generation[0]))) ? 1U : 0U;
+
+    /* Later checkpoints continue past every generation seen, torn ones included */
+    store->cp_generation = generation[newest];
+    store->cp_copy       = (uint8_t)(newest ^ 1U);
+
+    for (uint8_t attempt = 0U; attempt < APP_KV_CP_COPIES; attempt++)
+    {
+        const uint8_t copy = (uint8_t)(newest ^ attempt);
+
+        if (readable[copy] && app_kv_restore_checkpoint(copy))
+        {
+            store->cp_copy = (uint8_t)(copy ^ 1U);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Copy every live value into the other bank, then commit it with the header.
+ * Until the header is written the active bank and its index stay valid.
+ */
+static bool app_kv_compact(void)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    const uint8_t target = (uint8_t)(store->active_bank ^ 1U);
+    const uint32_t first_sequence = store->sequence;
+    uint16_t slot = (uint16_t)(APP_KV_HEADER_SLOT + 1U);
+
+    for (uint8_t index = 0U; index < APP_KV_MAX_KEYS; index++)
+    {
+        const app_kv_entry_t *entry = &store->entries[index];
+        app_kv_record_t content;
+
+        if (!entry->used)
+        {
+            continue;
+        }
+
+        content.key      = entry->key;
+        content.length   = entry->length;
+        content.sequence = store->sequence++;
+        content.value    = entry->value;
+
+        if (!app_kv_write_slot(target, slot, &content, entry->length))
+        {
+            return false;
+        }
+        slot++;
+    }
+
+    if (!app_kv_write_header(target, first_sequence))
+    {
+        return false;
+    }
+
+    store->head = slot;
+    store->stats.compactions++;
+
+    /* The old checkpoint names the old bank; boot would fall back to a scan */
+    store->cp_appends = store->cp_interval;
+    (void)app_kv_checkpoint(false);
+
+    return true;
+}
+
+static bool app_kv_append(uint8_t key, uint8_t length, const uint8_t *value)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    app_kv_record_t content;
+
+    if ((store->head >= store->bank_records) && !app_kv_compact())
+    {
+        return false;
+    }
+
+    content.key      = key;
+    content.length   = length;
+    content.sequence = store->sequence++;
+    content.value    = value;
+
+    if (!app_kv_write_slot(store->active_bank, store->head, &content,
+                           (uint8_t)(length & (uint8_t)~APP_KV_LENGTH_DELETED)))
+    {
+        return false;
+    }
+
+    store->head++;
+    store->cp_appends++;
+
+    /* Into the index first: a checkpoint taken now already counts this record */
+    app_kv_apply(&content);
+
+    if (store->cp_appends >= store->cp_interval)
+    {
+        (void)app_kv_checkpoint(false);
+    }
+
+    return true;
+}
+
+static bool app_kv_format(void)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    app_kv_scan_t scan = { 0U, UINT32_MAX, 0UL, 1U };
+
+    /* Start above any sequence left in the region so old records stay stale */
+    if (!app_kv_scan_bank(0U, &scan) || !app_kv_scan_bank(1U, &scan))
+    {
+        return false;
+    }
+
+    store->sequence = scan.max_sequence + 1UL;
+    store->head = (uint16_t)(APP_KV_HEADER_SLOT + 1U);
+
+    return app_kv_write_header(0U, store->sequence) && app_kv_checkpoint(true);
+}
+
+bool APP_KV_Init(const hal_i2c_m_eeprom_t *device, uint32_t base_address, uint32_t length)
+{
+    app_kv_store_t *store = &g_app_kv_store;
+    const uint32_t checkpoints = APP_KV_CP_COPIES * APP_KV_CHECKPOINT_SIZE;
+    const uint32_t bank_records = (length > checkpoints) ? ((length - checkpoints) / (2UL * APP_KV_RECORD_SIZE)) : 0UL;
+
+    (void)memset(store, 0, sizeof *store);
+
+    /* Whole records per page program, header plus every key plus one append per bank */
+    if ((device == NULL) ||
+        ((device->page_size % APP_KV_RECORD_SIZE) != 0U) ||
+        ((base_address % APP_KV_RECORD_SIZE) != 0UL) ||
+        ((length % (2UL * APP_KV_RECORD_SIZE)) != 0UL) ||
+        (base_address > device->size_bytes) ||
+        (length > (device->size_bytes - base_address)) ||
+        (bank_records < (APP_KV_MAX_KEYS + 2U)) ||
+        (bank_records > UINT16_MAX))
+    {
+        return false;
+    }
+
+    store->device       = device;
+    store->base_address = base_address;
+    store->bank_records = (uint16_t)bank_records;
+    /*
+     * One checkpoint per bank's worth of appends at most, so neither copy is
+     * written more often than a log slot; compaction starts a new interval.
+     */
+    store->cp_interval  = (bank_records > APP_KV_CHECKPOINT_INTERVAL) ? (uint16_t)bank_records
+                                                                       : (uint16_t)APP_KV_CHECKPOINT_INTERVAL;
+
+    if (app_kv_load_checkpoint())
+    {
+        store->stats.checkpoint_boot = true;
+        return true;
+    }
+
+    (void)memset(store->entries, 0, sizeof store->entries);
+    store->cp_appends = 0U;
+
+    uint32_t header_sequence[2] = { 0UL, 0UL };
+    uint32_t first_sequence[2] = { 0UL, 0UL };
+    const bool valid0 = app_kv_read_header(0U, &header_sequence[0], &first_sequence[0]);
+    const bool valid1 = app_kv_read_header(1U, &header_sequence[1], &first_sequence[1]);
+
+    if (!valid0 && !valid1)
+    {
+        return app_kv_format();
+    }
+
+    /* The newest committed header wins; a half-done compaction has none */
+    const uint8_t bank = (valid1 && (!valid0 || (header_sequence[1] > header_sequence[0]))) ? 1U : 0U;
+    app_kv_scan_t scan = { 0U, first_sequence[bank], header_sequence[bank ^ 1U], 1U };
+
+    if (!app_kv_scan_bank(bank, &scan))
+    {
+        return false;
+    }
+
+    store->active_bank     = bank;
+    store->header_sequence = header_sequence[bank];
+    store->head            = scan.next_head;
+    /*
+     * An interrupted compaction may have left copies in the other bank with
+     * sequences up to APP_KV_MAX_KEYS past this bank's newest; skip over them.
+     */
+    store->sequence        = scan.max_sequence + 1UL + APP_KV_MAX_KEYS;
+
+    /* So the next boot does not have to scan again */
+    (void)app_kv_checkpoint(true);
+
+    return true;
+}
+
+bool APP_KV_Get(uint8_t key, uint8_t *value, uint8_t capacity, uint8_t *length)
+{
+    const app_kv_entry_t *entry = app_kv_find(key);
+
+    if ((entry == NULL) || ((value == NULL) && (capacity > 0U)))
+    {
+        return false;
+    }
+
+    const uint8_t copy = (entry->length < capacity) ? entry->length : capacity;
+
+    if (copy > 0U)
+    {
+        (void)memcpy(value, entry->value, copy);
+    }
+
+    if (length != NULL)
+    {
+        *length = entry->length;
+    }
+
+    return true;
+}
+
+bool APP_KV_Set(uint8_t key, const uint8_t *value, uint8_t length)
+{
+    if ((g_app_kv_store.device == NULL) || (key == APP_KV_KEY_INVALID) ||
+        (length > APP_KV_VALUE_MAX) || ((value == NULL) && (length > 0U)))
+    {
+        return false;
+    }
+
+    const app_kv_entry_t *entry = app_kv_find(key);
+
+    if (entry != NULL)
+    {
+        /* Unchanged values cost no write */
+        if ((entry->length == length) && ((length == 0U) || (memcmp(entry->value, value, length) == 0)))
+        {
+            return true;
+        }
+    }
+    else if (app_kv_find_free() == NULL)
+    {
+        return false;
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    return app_kv_append(key, length, value);
+}
+
+bool APP_KV_Delete(uint8_t key)
+{
+    if (app_kv_find(key) == NULL)
+    {
+        return (g_app_kv_store.device != NULL);
+    }
+
+    return app_kv_append(key, APP_KV_LENGTH_DELETED, NULL);
+}
+
+bool APP_KV_Compact(void)
+{
+    if (g_app_kv_store.device == NULL)
+    {
+        return false;
+    }
+
+    return app_kv_compact();
+}
+
+bool APP_KV_Checkpoint(void)
+{
+    if (g_app_kv_store.device == NULL)
+    {
+        return false;
+    }
+
+    return app_kv_checkpoint(true);
+}
+
+void APP_KV_GetStats(app_kv_stats_t *stats)
+{
+    const app_kv_store_t *store = &g_app_kv_store;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = store->stats;
+    stats->sequence     = store->sequence;
+    stats->keys         = app_kv_live_count();
+    stats->active_bank  = store->active_bank;
+    stats->free_records = (store->head < store->bank_records) ? (uint16_t)(store->bank_records - store->head) : 0U;
+}
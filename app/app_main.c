@@ -2,6 +2,12 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "hal_i2c_slave.h"
+#include "hal_i2c_master.h"
+#include "hal_i2c_bus_monitor.h"
+#include "hal_eeprom_cache.h"
+#include "hal_gpio.h"
+#include "hal_gpio_input.h"
+#include "app_kv_store.h"
 #include "app_i2c_registers.h"
 #include "hal_scheduler.h"
 #include "r_cg_macrodriver.h"
@@ -33,6 +39,9 @@ static void process_message(const hal_i2c_message_t *message)
 static void Task_ProcessI2C(void)
 {
     hal_i2c_message_t message;
+    HAL_SCHED_CheckIn();
+    /* Evaluated every tick too, so a stalled Housekeeping is still recorded */
+    (void)HAL_SCHED_SupervisorHealthy();
     if (HAL_I2C_S_PopMessage(&message))
     {
         process_message(&message);
@@ -41,51 +50,99 @@ static void Task_ProcessI2C(void)
 
 static void Task_Housekeeping(void)
 {
-    (void)R_WDT_Restart();
+    HAL_SCHED_CheckIn();
+    /* Starve the watchdog once a monitored task stops checking in */
+    if (HAL_SCHED_SupervisorHealthy())
+    {
+        (void)R_WDT_Restart();
+    }
+}
+
+/* A record left by the previous run means the watchdog reset us: publish it, then re-arm */
+static void App_ReportStarvation(void)
+{
+    hal_sched_starvation_record_t record;
+
+    if (HAL_SCHED_GetStarvationRecord(&record))
+    {
+        APP_I2C_SetStarvationReport(record.task_index, record.uptime_ms, record.silent_ticks);
+    }
+    HAL_SCHED_ClearStarvationRecord();
 }
 
 static hal_sched_task_t g_tasks[] = {
-    { Task_ProcessI2C, UINT32_C(0), UINT16_C(1) },
-    { Task_Housekeeping, UINT32_C(0), UINT16_C(10) }
+    { .function = Task_ProcessI2C, .period_ticks = UINT16_C(1), .liveness_ticks = UINT16_C(50) },
+    { .function = Task_Housekeeping, .period_ticks = UINT16_C(10), .phase_ticks = HAL_SCHED_PHASE_AUTO,
+      .liveness_ticks = UINT16_C(50) },
+    { .coroutine = HAL_I2C_M_EEPROM_Task, .period_ticks = UINT16_C(1) },
+    { .function = HAL_I2C_M_Service, .period_ticks = UINT16_C(1) },
+    { .function = HAL_EEPROM_CACHE_IdleTask, .period_ticks = UINT16_C(10), .phase_ticks = HAL_SCHED_PHASE_AUTO },
+    { .function = HAL_I2C_BUS_Task, .period_ticks = UINT16_C(5), .phase_ticks = HAL_SCHED_PHASE_AUTO },
+    { .function = HAL_GPIO_INPUT_Task, .period_ticks = UINT16_C(1) }
 };
 
-static void App_I2C_ErrorHandler(const hal_i2c_error_context_t *context)
+/* Deferred work argument: error code in the low byte, slave event id above it */
+#define APP_I2C_RECOVERY_ARG(code, event_id)  ((uint16_t)(((uint16_t)(event_id) << 8) | (uint16_t)(code)))
+
+static void App_I2C_RecoverBus(uint16_t argument)
 {
-    if (context == NULL)
-    {
-        return;
-    }
-    switch (context->code)
+    const hal_i2c_error_t code = (hal_i2c_error_t)(argument & 0xFFU);
+    const uint8_t event_id = (uint8_t)(argument >> 8);
+
+    switch (code)
     {
         case HAL_I2C_ERR_BUS_ERROR:
         case HAL_I2C_ERR_LINE_STUCK:
-            R_Config_IICA0_ResetBusLines();
-            HAL_I2C_S_Reset();
-            break;
-        case HAL_I2C_ERR_OVERRUN:
-            HAL_I2C_S_Reset();
+        case HAL_I2C_ERR_ARBITRATION_LOST:
+            /* Classified and rate limited; may re-arm, pulse or reset */
+            HAL_I2C_BUS_ReportFault(code, event_id);
             break;
         case HAL_I2C_ERR_TIMEOUT:
+            /* A frame stalled mid-byte may have wedged reception: re-arm it */
+            (void)HAL_I2C_S_RecoverEvent(event_id, HAL_I2C_RECOVERY_MEDIUM);
+            break;
+        case HAL_I2C_ERR_OVERRUN:
         case HAL_I2C_ERR_NACK:
-        case HAL_I2C_ERR_ARBITRATION_LOST:
         case HAL_I2C_ERR_FRAME:
         default:
-            HAL_I2C_S_Reset();
+            /* The ISR already dropped the frame; this only runs if it did less */
+            (void)HAL_I2C_S_RecoverEvent(event_id, HAL_I2C_RECOVERY_LIGHT);
             break;
     }
 }
 
+/* Runs in interrupt context: hand recovery over to the scheduler. */
+static void App_I2C_ErrorHandler(const hal_i2c_error_context_t *context)
+{
+    if (context == NULL)
+    {
+        return;
+    }
+    (void)HAL_SCHED_Defer(App_I2C_RecoverBus, APP_I2C_RECOVERY_ARG(context->code, context->event_id));
+}
+
 int main(void)
 {
     R_Systeminit();
+    /* Board pins, probe outputs included, before any ISR can drive them */
+    HAL_GPIO_Init();
+    /* Seed the debounced inputs from the configured pins before the first sample task */
+    (void)HAL_GPIO_INPUT_Init();
     __enable_interrupt();
-    HAL_SCHED_Init(UINT16_C(1000));
+    App_ReportStarvation();
+    (void)HAL_SCHED_Init(UINT16_C(1000));
+    HAL_I2C_BUS_Init();
+    HAL_I2C_S_Init(App_I2C_ErrorHandler);
+    HAL_I2C_M_Init();
+    (void)HAL_EEPROM_CACHE_Init(HAL_I2C_M_EEPROM(HAL_I2C_M_EEPROM_MAIN));
+    (void)APP_KV_Init(HAL_I2C_M_EEPROM(HAL_I2C_M_EEPROM_MAIN), APP_KV_REGION_BASE, APP_KV_REGION_SIZE);
+    (void)R_WDT_Restart();
+    /* After the blocking storage scan, so liveness is measured from here */
     const size_t count = sizeof g_tasks / sizeof g_tasks[0];
     if (count <= (size_t)UINT8_MAX)
     {
         HAL_SCHED_RegisterTasks(g_tasks, (uint8_t)count);
     }
-    HAL_I2C_S_Init(App_I2C_ErrorHandler);
     for (;;)
     {
         HAL_SCHED_RunOnce();
@@ -0,0 +1,378 @@
+#include "hal_eeprom_cache.h"
+#include "hal_scheduler.h"
+
+#include <stddef.h>
+#include <string.h>
+
+typedef struct
+{
+    uint32_t line_address;
+    uint16_t dirty_first;
+    uint16_t dirty_last;    /* exclusive; equal to dirty_first when clean */
+    uint16_t last_use;
+    bool     valid;
+    bool     flushing;      /* data[] referenced by the background writer */
+    uint8_t  data[HAL_EEPROM_CACHE_LINE_SIZE];
+} hal_eeprom_cache_line_t;
+
+typedef struct
+{
+    const hal_i2c_m_eeprom_t *device;
+    hal_eeprom_cache_line_t  lines[HAL_EEPROM_CACHE_LINES];
+    hal_eeprom_cache_line_t *flush_line;
+    uint16_t                 flush_first;
+    uint16_t                 flush_last;
+    hal_i2c_m_eeprom_status_t flush_status;    /* set by the write callback */
+    uint16_t                 use_counter;
+    uint32_t                 last_write_ms;
+    hal_eeprom_cache_stats_t stats;
+} hal_eeprom_cache_t;
+
+static hal_eeprom_cache_t g_hal_eeprom_cache;
+
+static bool hal_eeprom_cache_is_dirty(const hal_eeprom_cache_line_t *line)
+{
+    return (line->dirty_last > line->dirty_first);
+}
+
+static void hal_eeprom_cache_mark_dirty(hal_eeprom_cache_line_t *line, uint16_t first, uint16_t last)
+{
+    if (!hal_eeprom_cache_is_dirty(line))
+    {
+        line->dirty_first = first;
+        line->dirty_last  = last;
+    }
+    else
+    {
+        line->dirty_first = (first < line->dirty_first) ? first : line->dirty_first;
+        line->dirty_last  = (last > line->dirty_last) ? last : line->dirty_last;
+    }
+}
+
+static void hal_eeprom_cache_touch(hal_eeprom_cache_line_t *line)
+{
+    g_hal_eeprom_cache.use_counter++;
+    line->last_use = g_hal_eeprom_cache.use_counter;
+}
+
+/* Completion of our own background write only; other writers do not touch it */
+static void hal_eeprom_cache_flush_done(bool success, void *context)
+{
+    hal_eeprom_cache_t *cache = (hal_eeprom_cache_t *)context;
+
+    cache->flush_status = success ? HAL_I2C_M_EEPROM_DONE : HAL_I2C_M_EEPROM_FAILED;
+}
+
+/* Retire a finished background write; false while it is still running. */
+static bool hal_eeprom_cache_poll_flush(void)
+{
+    hal_eeprom_cache_t *cache = &g_hal_eeprom_cache;
+    hal_eeprom_cache_line_t *line = cache->flush_line;
+
+    if (line == NULL)
+    {
+        return true;
+    }
+
+    if (cache->flush_status == HAL_I2C_M_EEPROM_BUSY)
+    {
+        return false;
+    }
+
+    if (cache->flush_status == HAL_I2C_M_EEPROM_DONE)
+    {
+        cache->stats.page_writes++;
+    }
+    else
+    {
+        /* Keep the data; it goes out again with the next flush */
+        hal_eeprom_cache_mark_dirty(line, cache->flush_first, cache->flush_last);
+    }
+
+    line->flushing    = false;
+    cache->flush_line = NULL;
+
+    return true;
+}
+
+static bool hal_eeprom_cache_write_back(hal_eeprom_cache_line_t *line)
+{
+    if (!hal_eeprom_cache_is_dirty(line))
+    {
+        return true;
+    }
+
+    const uint16_t first = line->dirty_first;
+    const uint16_t length = (uint16_t)(line->dirty_last - line->dirty_first);
+
+    if (!HAL_I2C_M_EEPROM_Write(g_hal_eeprom_cache.device, line->line_address + first, &line->data[first], length))
+    {
+        return false;
+    }
+
+    line->dirty_first = 0U;
+    line->dirty_last  = 0U;
+    g_hal_eeprom_cache.stats.page_writes++;
+
+    return true;
+}
+
+static hal_eeprom_cache_line_t *hal_eeprom_cache_find(uint32_t line_address)
+{
+    for (uint8_t index = 0U; index < HAL_EEPROM_CACHE_LINES; index++)
+    {
+        hal_eeprom_cache_line_t *line = &g_hal_eeprom_cache.lines[index];
+
+        if (line->valid && (line->line_address == line_address))
+        {
+            return line;
+        }
+    }
+
+    return NULL;
+}
+
+static hal_eeprom_cache_line_t *hal_eeprom_cache_allocate(uint32_t line_address, bool fill)
+{
+    hal_eeprom_cache_t *cache = &g_hal_eeprom_cache;
+    hal_eeprom_cache_line_t *victim = NULL;
+    uint16_t oldest_age = 0U;
+
+    /* The device may be mid write cycle while a background flush runs */
+    if (!hal_eeprom_cache_poll_flush() && !HAL_I2C_M_EEPROM_WaitReady(cache->device))
+    {
+        return NULL;
+    }
+
+    for (uint8_t index = 0U; index < HAL_EEPROM_CACHE_LINES; index++)
+    {
+        hal_eeprom_cache_line_t *line = &cache->lines[index];
+
+        if (line->flushing)
+        {
+            continue;
+        }
+
+        if (!line->valid)
+        {
+            victim = line;
+            break;
+        }
+
+        const uint16_t age = (uint16_t)(cache->use_counter - line->last_use);
+
+        if ((victim == NULL) || (age > oldest_age))
+        {
+            victim     = line;
+            oldest_age = age;
+        }
+    }
+
+    if ((victim == NULL) || (victim->valid && !hal_eeprom_cache_write_back(victim)))
+    {
+        return NULL;
+    }
+
+    victim->valid = false;
+
+    if (fill && !HAL_I2C_M_EEPROM_Read(cache->device, line_address, victim->data, HAL_EEPROM_CACHE_LINE_SIZE))
+    {
+        return NULL;
+    }
+
+    victim->line_address = line_address;
+    victim->dirty_first  = 0U;
+    victim->dirty_last   = 0U;
+    victim->valid        = true;
+
+    return victim;
+}
+
+bool HAL_EEPROM_CACHE_Init(const hal_i2c_m_eeprom_t *device)
+{
+    (void)memset(&g_hal_eeprom_cache, 0, sizeof g_hal_eeprom_cache);
+
+    /* Lines never straddle a page or the end of the part */
+    if ((device == NULL) || ((device->page_size % HAL_EEPROM_CACHE_LINE_SIZE) != 0U) ||
+        ((device->size_bytes % HAL_EEPROM_CACHE_LINE_SIZE) != 0U))
+    {
+        return false;
+    }
+
+    g_hal_eeprom_cache.device = device;
+
+    return true;
+}
+
+bool HAL_EEPROM_CACHE_Read(uint32_t memory_address, uint8_t *data, uint16_t length)
+{
+    if ((data == NULL) || (length == 0U) || (g_hal_eeprom_cache.device == NULL))
+    {
+        return false;
+    }
+
+    uint16_t done = 0U;
+
+    while (done < length)
+    {
+        const uint32_t address = memory_address + done;
+        const uint16_t offset = (uint16_t)(address % HAL_EEPROM_CACHE_LINE_SIZE);
+        const uint32_t line_address = address - offset;
+        uint16_t chunk = (uint16_t)(HAL_EEPROM_CACHE_LINE_SIZE - offset);
+        hal_eeprom_cache_line_t *line = hal_eeprom_cache_find(line_address);
+
+        if (chunk > (uint16_t)(length - done))
+        {
+            chunk = (uint16_t)(length - done);
+        }
+
+        if (line != NULL)
+        {
+            g_hal_eeprom_cache.stats.read_hits++;
+        }
+        else
+        {
+            g_hal_eeprom_cache.stats.read_misses++;
+            line = hal_eeprom_cache_allocate(line_address, true);
+            if (line == NULL)
+            {
+                return false;
+            }
+        }
+
+        hal_eeprom_cache_touch(line);
+        (void)memcpy(&data[done], &line->data[offset], chunk);
+        done = (uint16_t)(done + chunk);
+    }
+
+    return true;
+}
+
+bool HAL_EEPROM_CACHE_Write(uint32_t memory_address, const uint8_t *data, uint16_t length)
+{
+    if ((data == NULL) || (length == 0U) || (g_hal_eeprom_cache.device == NULL))
+    {
+        return false;
+    }
+
+    uint16_t done = 0U;
+
+    g_hal_eeprom_cache.stats.writes++;
+
+    while (done < length)
+    {
+        const uint32_t address = memory_address + done;
+        const uint16_t offset = (uint16_t)(address % HAL_EEPROM_CACHE_LINE_SIZE);
+        const uint32_t line_address = address - offset;
+        uint16_t chunk = (uint16_t)(HAL_EEPROM_CACHE_LINE_SIZE - offset);
+        hal_eeprom_cache_line_t *line = hal_eeprom_cache_find(line_address);
+
+        if (chunk > (uint16_t)(length - done))
+        {
+            chunk = (uint16_t)(length - done);
+        }
+
+        if (line == NULL)
+        {
+            /* A whole-line write needs no read of the old contents */
+            line = hal_eeprom_cache_allocate(line_address, chunk != HAL_EEPROM_CACHE_LINE_SIZE);
+            if (line == NULL)
+            {
+                return false;
+            }
+        }
+
+        hal_eeprom_cache_touch(line);
+        (void)memcpy(&line->data[offset], &data[done], chunk);
+        hal_eeprom_cache_mark_dirty(line, offset, (uint16_t)(offset + chunk));
+        done = (uint16_t)(done + chunk);
+    }
+
+    g_hal_eeprom_cache.last_write_ms = HAL_SCHED_GetUptimeMs();
+
+    return true;
+}
+
+bool HAL_EEPROM_CACHE_Flush(void)
+{
+    if (!hal_eeprom_cache_poll_flush())
+    {
+        return false;
+    }
+
+    for (uint8_t index = 0U; index < HAL_EEPROM_CACHE_LINES; index++)
+    {
+        hal_eeprom_cache_line_t *line = &g_hal_eeprom_cache.lines[index];
+
+        if (line->valid && !hal_eeprom_cache_write_back(line))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void HAL_EEPROM_CACHE_Invalidate(void)
+{
+    for (uint8_t index = 0U; index < HAL_EEPROM_CACHE_LINES; index++)
+    {
+        hal_eeprom_cache_line_t *line = &g_hal_eeprom_cache.lines[index];
+
+        /* A line under background write keeps its flushing mark until retired */
+        line->valid       = false;
+        line->dirty_first = 0U;
+        line->dirty_last  = 0U;
+    }
+}
+
+void HAL_EEPROM_CACHE_IdleTask(void)
+{
+    hal_eeprom_cache_t *cache = &g_hal_eeprom_cache;
+
+    if (!hal_eeprom_cache_poll_flush())
+    {
+        return;
+    }
+
+    if ((uint32_t)(HAL_SCHED_GetUptimeMs() - cache->last_write_ms) < HAL_EEPROM_CACHE_IDLE_FLUSH_MS)
+    {
+        return;
+    }
+
+    for (uint8_t index = 0U; index < HAL_EEPROM_CACHE_LINES; index++)
+    {
+        hal_eeprom_cache_line_t *line = &cache->lines[index];
+
+        if (!line->valid || !hal_eeprom_cache_is_dirty(line))
+        {
+            continue;
+        }
+
+        const uint16_t first = line->dirty_first;
+        const uint16_t length = (uint16_t)(line->dirty_last - line->dirty_first);
+
+        if (HAL_I2C_M_EEPROM_WriteAsync(cache->device, line->line_address + first, &line->data[first], length,
+                                        hal_eeprom_cache_flush_done, cache))
+        {
+            cache->flush_status = HAL_I2C_M_EEPROM_BUSY;
+            cache->flush_line   = line;
+            cache->flush_first  = line->dirty_first;
+            cache->flush_last   = line->dirty_last;
+            line->flushing      = true;
+            line->dirty_first   = 0U;
+            line->dirty_last    = 0U;
+        }
+        break;
+    }
+}
+
+void HAL_EEPROM_CACHE_GetStats(hal_eeprom_cache_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = g_hal_eeprom_cache.stats;
+}
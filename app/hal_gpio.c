@@ -1,23 +1,24 @@
 #include "hal_gpio.h"
 #include "hal_gpio_board.h"
 #include "hal_gpio_pinmap.h"
+#include "hal_critical.h"
 
 #include <stddef.h>
 
-#if HAL_GPIO_PIN_COUNT > 0
-const hal_gpio_pin_config_t g_hal_gpio_pinmap[HAL_GPIO_PIN_COUNT] =
+#define HAL_GPIO_GROUP_BITS  ((uint8_t)(sizeof(hal_gpio_group_t) * 8U))
+
+/*
+ * HAL_GPIO_PIN_COUNT is an enumerator, invisible to #if, so the array always
+ * carries one unused trailing slot and is never zero-sized.
+ */
+const hal_gpio_pin_config_t g_hal_gpio_pinmap[HAL_GPIO_PIN_COUNT + 1] =
 {
 #define HAL_GPIO_DEFINE_ENTRY(name, port_reg, direction_reg, pullup_reg, input_reg, mask, default_mode, default_level, inverted) \
     [name] = { (port_reg), (direction_reg), (pullup_reg), (input_reg), (uint8_t)(mask), (default_mode), (default_level), (inverted) },
     HAL_GPIO_PIN_TABLE(HAL_GPIO_DEFINE_ENTRY)
 #undef HAL_GPIO_DEFINE_ENTRY
+    [HAL_GPIO_PIN_COUNT] = { NULL, NULL, NULL, NULL, 0U, HAL_GPIO_MODE_INPUT, HAL_GPIO_LEVEL_LOW, false }
 };
-#else
-const hal_gpio_pin_config_t g_hal_gpio_pinmap[1] =
-{
-    { NULL, NULL, NULL, NULL, 0U, HAL_GPIO_MODE_INPUT, HAL_GPIO_LEVEL_LOW, false }
-};
-#endif
 
 const uint8_t g_hal_gpio_pinmap_count = (uint8_t)HAL_GPIO_PIN_COUNT;
 
@@ -25,7 +26,11 @@ static const hal_gpio_pin_config_t *hal_gpio_get_config(hal_gpio_pin_id_t pin);
 static void hal_gpio_set_pullup(const hal_gpio_pin_config_t *cfg, bool enable);
 static bool hal_gpio_set_mode_raw(const hal_gpio_pin_config_t *cfg, hal_gpio_mode_t mode);
 static bool hal_gpio_write_raw(const hal_gpio_pin_config_t *cfg, hal_gpio_level_t level);
+static void hal_gpio_modify(volatile uint8_t *port_reg, uint8_t clear_mask, uint8_t set_mask);
+static void hal_gpio_restore_bits(volatile uint8_t *reg, uint8_t mask, uint8_t value);
 static bool hal_gpio_read_raw(const hal_gpio_pin_config_t *cfg, hal_gpio_level_t *level);
+static const volatile uint8_t *hal_gpio_input_reg(const hal_gpio_pin_config_t *cfg);
+static bool hal_gpio_group_valid(hal_gpio_group_t pins);
 
 void HAL_GPIO_Init(void)
 {
@@ -84,21 +89,252 @@ bool HAL_GPIO_Read(hal_gpio_pin_id_t pin, hal_gpio_level_t *level)
     return hal_gpio_read_raw(cfg, level);
 }
 
+bool HAL_GPIO_Set(hal_gpio_pin_id_t pin)
+{
+    return HAL_GPIO_Write(pin, HAL_GPIO_LEVEL_HIGH);
+}
+
+bool HAL_GPIO_Clear(hal_gpio_pin_id_t pin)
+{
+    return HAL_GPIO_Write(pin, HAL_GPIO_LEVEL_LOW);
+}
+
 bool HAL_GPIO_Toggle(hal_gpio_pin_id_t pin)
 {
-    hal_gpio_level_t current = HAL_GPIO_LEVEL_LOW;
+    const hal_gpio_pin_config_t *cfg = hal_gpio_get_config(pin);
+    hal_critical_state_t state;
 
-    if (!HAL_GPIO_Read(pin, &current))
+    if (cfg == NULL)
     {
         return false;
     }
 
-    if (current == HAL_GPIO_LEVEL_HIGH)
+    /* Flip the output latch; the pin level may lag behind a loaded output */
+    HAL_CRITICAL_ENTER(state);
+    *cfg->port_reg ^= cfg->mask;
+    HAL_CRITICAL_EXIT(state);
+
+    return true;
+}
+
+bool HAL_GPIO_WriteGroup(hal_gpio_group_t pins, hal_gpio_group_t levels)
+{
+    volatile uint8_t *ports[HAL_GPIO_GROUP_MAX_PORTS];
+    uint8_t set_masks[HAL_GPIO_GROUP_MAX_PORTS];
+    uint8_t clear_masks[HAL_GPIO_GROUP_MAX_PORTS];
+    uint8_t port_count = 0U;
+
+    if (!hal_gpio_group_valid(pins))
     {
-        return HAL_GPIO_Write(pin, HAL_GPIO_LEVEL_LOW);
+        return false;
     }
 
-    return HAL_GPIO_Write(pin, HAL_GPIO_LEVEL_HIGH);
+    /* Fold the group into one set and one clear mask per port */
+    for (uint8_t idx = 0U; idx < HAL_GPIO_GROUP_BITS; ++idx)
+    {
+        const hal_gpio_group_t bit = HAL_GPIO_GROUP_PIN(idx);
+
+        if ((pins & bit) == 0U)
+        {
+            continue;
+        }
+
+        const hal_gpio_pin_config_t *cfg = &g_hal_gpio_pinmap[idx];
+        uint8_t slot = 0U;
+
+        while ((slot < port_count) && (ports[slot] != cfg->port_reg))
+        {
+            slot++;
+        }
+
+        if (slot == port_count)
+        {
+            if (port_count >= HAL_GPIO_GROUP_MAX_PORTS)
+            {
+                return false;
+            }
+
+            ports[slot]       = cfg->port_reg;
+            set_masks[slot]   = 0U;
+            clear_masks[slot] = 0U;
+            port_count++;
+        }
+
+        if (((levels & bit) != 0U) != cfg->inverted)
+        {
+            set_masks[slot] |= cfg->mask;
+        }
+        else
+        {
+            clear_masks[slot] |= cfg->mask;
+        }
+    }
+
+    for (uint8_t slot = 0U; slot < port_count; ++slot)
+    {
+        hal_gpio_modify(ports[slot], clear_masks[slot], set_masks[slot]);
+    }
+
+    return true;
+}
+
+bool HAL_GPIO_ReadGroup(hal_gpio_group_t pins, hal_gpio_group_t *levels)
+{
+    const volatile uint8_t *inputs[HAL_GPIO_GROUP_MAX_PORTS];
+    uint8_t samples[HAL_GPIO_GROUP_MAX_PORTS];
+    uint8_t input_count = 0U;
+    hal_gpio_group_t result = 0U;
+
+    if ((levels == NULL) || !hal_gpio_group_valid(pins))
+    {
+        return false;
+    }
+
+    for (uint8_t idx = 0U; idx < HAL_GPIO_GROUP_BITS; ++idx)
+    {
+        const hal_gpio_group_t bit = HAL_GPIO_GROUP_PIN(idx);
+
+        if ((pins & bit) == 0U)
+        {
+            continue;
+        }
+
+        const hal_gpio_pin_config_t *cfg = &g_hal_gpio_pinmap[idx];
+        const volatile uint8_t *input_reg = hal_gpio_input_reg(cfg);
+        uint8_t slot = 0U;
+
+        while ((slot < input_count) && (inputs[slot] != input_reg))
+        {
+            slot++;
+        }
+
+        if (slot == input_count)
+        {
+            if (input_count >= HAL_GPIO_GROUP_MAX_PORTS)
+            {
+                return false;
+            }
+
+            /* One sample per register keeps pins of a port coherent */
+            inputs[slot]  = input_reg;
+            samples[slot] = *input_reg;
+            input_count++;
+        }
+
+        if (((samples[slot] & cfg->mask) != 0U) != cfg->inverted)
+        {
+            result |= bit;
+        }
+    }
+
+    *levels = result;
+
+    return true;
+}
+
+void HAL_GPIO_SnapshotPins(const hal_gpio_port_pins_t *pins, hal_gpio_port_snapshot_t *snapshot)
+{
+    if ((pins == NULL) || (snapshot == NULL))
+    {
+        return;
+    }
+
+    snapshot->port      = (pins->port_reg != NULL) ? *pins->port_reg : 0U;
+    snapshot->direction = (pins->direction_reg != NULL) ? *pins->direction_reg : 0U;
+    snapshot->pullup    = (pins->pullup_reg != NULL) ? *pins->pullup_reg : 0U;
+    snapshot->mode_ctl  = (pins->mode_ctl_reg != NULL) ? *pins->mode_ctl_reg : 0U;
+}
+
+void HAL_GPIO_ClaimPins(const hal_gpio_port_pins_t *pins, hal_gpio_port_snapshot_t *snapshot)
+{
+    if ((pins == NULL) || (snapshot == NULL))
+    {
+        return;
+    }
+
+    HAL_GPIO_SnapshotPins(pins, snapshot);
+    hal_gpio_restore_bits(pins->mode_ctl_reg, pins->mask, 0U);
+    hal_gpio_restore_bits(pins->pullup_reg, pins->mask, pins->mask);
+    hal_gpio_restore_bits(pins->direction_reg, pins->mask, pins->mask);
+    /* Inputs now, so a low latch is never driven until the caller pulls a line */
+    hal_gpio_restore_bits(pins->port_reg, pins->mask, 0U);
+}
+
+void HAL_GPIO_RestorePins(const hal_gpio_port_pins_t *pins, const hal_gpio_port_snapshot_t *snapshot)
+{
+    if ((pins == NULL) || (snapshot == NULL))
+    {
+        return;
+    }
+
+    hal_gpio_restore_bits(pins->pullup_reg, pins->mask, snapshot->pullup);
+    hal_gpio_restore_bits(pins->mode_ctl_reg, pins->mask, snapshot->mode_ctl);
+    hal_gpio_restore_bits(pins->port_reg, pins->mask, snapshot->port);
+    hal_gpio_restore_bits(pins->direction_reg, pins->mask, snapshot->direction);
+}
+
+bool HAL_GPIO_SnapshotGroup(hal_gpio_group_t pins, hal_gpio_group_snapshot_t *snapshot)
+{
+    if ((snapshot == NULL) || !hal_gpio_group_valid(pins))
+    {
+        return false;
+    }
+
+    snapshot->count = 0U;
+
+    for (uint8_t idx = 0U; idx < HAL_GPIO_GROUP_BITS; ++idx)
+    {
+        if ((pins & HAL_GPIO_GROUP_PIN(idx)) == 0U)
+        {
+            continue;
+        }
+
+        const hal_gpio_pin_config_t *cfg = &g_hal_gpio_pinmap[idx];
+        uint8_t slot = 0U;
+
+        while ((slot < snapshot->count) && (snapshot->ports[slot].port_reg != cfg->port_reg))
+        {
+            slot++;
+        }
+
+        if (slot == snapshot->count)
+        {
+            if (snapshot->count >= HAL_GPIO_GROUP_MAX_PORTS)
+            {
+                snapshot->count = 0U;
+                return false;
+            }
+
+            snapshot->ports[slot].port_reg      = cfg->port_reg;
+            snapshot->ports[slot].direction_reg = cfg->direction_reg;
+            snapshot->ports[slot].pullup_reg    = cfg->pullup_reg;
+            snapshot->ports[slot].mode_ctl_reg  = NULL;
+            snapshot->ports[slot].mask          = 0U;
+            snapshot->count++;
+        }
+
+        snapshot->ports[slot].mask |= cfg->mask;
+    }
+
+    for (uint8_t slot = 0U; slot < snapshot->count; ++slot)
+    {
+        HAL_GPIO_SnapshotPins(&snapshot->ports[slot], &snapshot->saved[slot]);
+    }
+
+    return true;
+}
+
+void HAL_GPIO_RestoreGroup(const hal_gpio_group_snapshot_t *snapshot)
+{
+    if (snapshot == NULL)
+    {
+        return;
+    }
+
+    for (uint8_t slot = 0U; slot < snapshot->count; ++slot)
+    {
+        HAL_GPIO_RestorePins(&snapshot->ports[slot], &snapshot->saved[slot]);
+    }
 }
 
 uint8_t HAL_GPIO_PinCount(void)
@@ -178,22 +414,31 @@ static bool hal_gpio_write_raw(const hal_gpio_pin_config_t *cfg, hal_gpio_level_
         drive_high = !drive_high;
     }
 
-    uint8_t port_value = *cfg->port_reg;
-
     if (drive_high)
     {
-        port_value |= cfg->mask;
+        hal_gpio_modify(cfg->port_reg, 0U, cfg->mask);
     }
     else
     {
-        port_value &= (uint8_t)(~cfg->mask);
+        hal_gpio_modify(cfg->port_reg, cfg->mask, 0U);
     }
 
-    *cfg->port_reg = port_value;
-
     return true;
 }
 
+/*
+ * Read-modify-write of a port latch with interrupts masked, so an ISR
+ * driving another pin of the same port cannot have its update overwritten.
+ */
+static void hal_gpio_modify(volatile uint8_t *port_reg, uint8_t clear_mask, uint8_t set_mask)
+{
+    hal_critical_state_t state;
+
+    HAL_CRITICAL_ENTER(state);
+    *port_reg = (uint8_t)((*port_reg & (uint8_t)(~clear_mask)) | set_mask);
+    HAL_CRITICAL_EXIT(state);
+}
+
 static bool hal_gpio_read_raw(const hal_gpio_pin_config_t *cfg, hal_gpio_level_t *level)
 {
     if ((cfg == NULL) || (level == NULL))
@@ -201,12 +446,7 @@ static bool hal_gpio_read_raw(const hal_gpio_pin_config_t *cfg, hal_gpio_level_t
         return false;
     }
 
-    const volatile uint8_t *input_reg = cfg->input_reg;
-
-    if (input_reg == NULL)
-    {
-        input_reg = cfg->port_reg;
-    }
+    const volatile uint8_t *input_reg = hal_gpio_input_reg(cfg);
 
     if (input_reg == NULL)
     {
@@ -224,3 +464,35 @@ static bool hal_gpio_read_raw(const hal_gpio_pin_config_t *cfg, hal_gpio_level_t
 
     return true;
 }
+
+static const volatile uint8_t *hal_gpio_input_reg(const hal_gpio_pin_config_t *cfg)
+{
+    if (cfg->input_reg != NULL)
+    {
+        return cfg->input_reg;
+    }
+
+    return cfg->port_reg;
+}
+
+static bool hal_gpio_group_valid(hal_gpio_group_t pins)
+{
+    for (uint8_t idx = 0U; idx < HAL_GPIO_GROUP_BITS; ++idx)
+    {
+        if (((pins & HAL_GPIO_GROUP_PIN(idx)) != 0U) && !HAL_GPIO_IsValid((hal_gpio_pin_id_t)idx))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Masked write of a register that may not exist on this device. */
+static void hal_gpio_restore_bits(volatile uint8_t *reg, uint8_t mask, uint8_t value)
+{
+    if (reg != NULL)
+    {
+        hal_gpio_modify(reg, mask, (uint8_t)(value & mask));
+    }
+}
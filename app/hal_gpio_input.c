@@ -0,0 +1,223 @@
+#include "hal_gpio_input.h"
+#include "hal_gpio_board.h"
+#include "hal_gpio_pinmap.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define HAL_GPIO_INPUT_NO_PORT  (0xFFU)
+#define HAL_GPIO_INPUT_GROUP_BITS  ((uint8_t)(sizeof(hal_gpio_group_t) * 8U))
+
+typedef struct
+{
+    const volatile uint8_t *input_reg;
+    uint8_t                 mask;      /* input pins read through this register */
+    uint8_t                 invert;    /* inverted pins among them */
+    uint8_t                 state;     /* debounced logical levels */
+    uint8_t                 count0;    /* vertical counter, low bits */
+    uint8_t                 count1;    /* vertical counter, high bits */
+} hal_gpio_input_port_t;
+
+typedef struct
+{
+    hal_gpio_group_t          pins;
+    hal_gpio_edge_t           edges;
+    hal_gpio_input_callback_t callback;
+} hal_gpio_input_subscriber_t;
+
+typedef struct
+{
+    hal_gpio_input_port_t       ports[HAL_GPIO_INPUT_MAX_PORTS];
+    uint8_t                     port_count;
+    uint8_t                     pin_port[HAL_GPIO_PIN_COUNT + 1];
+    hal_gpio_input_subscriber_t subscribers[HAL_GPIO_INPUT_MAX_SUBSCRIBERS];
+    uint8_t                     subscriber_count;
+    hal_gpio_input_stats_t      stats;
+} hal_gpio_input_t;
+
+static hal_gpio_input_t g_hal_gpio_input;
+
+static bool hal_gpio_input_is_input(const hal_gpio_pin_config_t *cfg)
+{
+    return (cfg->port_reg != NULL) && (cfg->direction_reg != NULL) &&
+           ((cfg->default_mode == HAL_GPIO_MODE_INPUT) || (cfg->default_mode == HAL_GPIO_MODE_INPUT_PULLUP));
+}
+
+static uint8_t hal_gpio_input_sample(const hal_gpio_input_port_t *port)
+{
+    return (uint8_t)((*port->input_reg ^ port->invert) & port->mask);
+}
+
+/* Hand the changed pins of one port to their subscribers. */
+static void hal_gpio_input_post(uint8_t slot, uint8_t changed)
+{
+    hal_gpio_input_t *input = &g_hal_gpio_input;
+    const hal_gpio_input_port_t *port = &input->ports[slot];
+
+    for (uint8_t idx = 0U; idx < g_hal_gpio_pinmap_count; ++idx)
+    {
+        const uint8_t mask = g_hal_gpio_pinmap[idx].mask;
+
+        if ((input->pin_port[idx] != slot) || ((changed & mask) == 0U))
+        {
+            continue;
+        }
+
+        const hal_gpio_edge_t edge = ((port->state & mask) != 0U) ? HAL_GPIO_EDGE_RISING : HAL_GPIO_EDGE_FALLING;
+
+        input->stats.edges++;
+
+        if (idx >= HAL_GPIO_INPUT_GROUP_BITS)
+        {
+            continue;
+        }
+
+        for (uint8_t sub = 0U; sub < input->subscriber_count; ++sub)
+        {
+            const hal_gpio_input_subscriber_t *subscriber = &input->subscribers[sub];
+
+            if (((subscriber->pins & HAL_GPIO_GROUP_PIN(idx)) != 0U) &&
+                (((uint8_t)subscriber->edges & (uint8_t)edge) != 0U))
+            {
+                subscriber->callback((hal_gpio_pin_id_t)idx, edge);
+            }
+        }
+    }
+}
+
+bool HAL_GPIO_INPUT_Init(void)
+{
+    hal_gpio_input_t *input = &g_hal_gpio_input;
+
+    (void)memset(input, 0, sizeof *input);
+    (void)memset(input->pin_port, HAL_GPIO_INPUT_NO_PORT, sizeof input->pin_port);
+
+    for (uint8_t idx = 0U; idx < g_hal_gpio_pinmap_count; ++idx)
+    {
+        const hal_gpio_pin_config_t *cfg = &g_hal_gpio_pinmap[idx];
+
+        if (!hal_gpio_input_is_input(cfg))
+        {
+            continue;
+        }
+
+        const volatile uint8_t *input_reg = hal_gpio_fast_input(cfg->input_reg, cfg->port_reg);
+        uint8_t slot = 0U;
+
+        while ((slot < input->port_count) && (input->ports[slot].input_reg != input_reg))
+        {
+            slot++;
+        }
+
+        if (slot == input->port_count)
+        {
+            if (input->port_count >= HAL_GPIO_INPUT_MAX_PORTS)
+            {
+                return false;
+            }
+
+            input->ports[slot].input_reg = input_reg;
+            input->port_count++;
+        }
+
+        input->ports[slot].mask |= cfg->mask;
+        if (cfg->inverted)
+        {
+            input->ports[slot].invert |= cfg->mask;
+        }
+        input->pin_port[idx] = slot;
+    }
+
+    for (uint8_t slot = 0U; slot < input->port_count; ++slot)
+    {
+        input->ports[slot].state = hal_gpio_input_sample(&input->ports[slot]);
+    }
+
+    input->stats.ports = input->port_count;
+
+    return true;
+}
+
+void HAL_GPIO_INPUT_Task(void)
+{
+    hal_gpio_input_t *input = &g_hal_gpio_input;
+
+    input->stats.samples++;
+
+    for (uint8_t slot = 0U; slot < input->port_count; ++slot)
+    {
+        hal_gpio_input_port_t *port = &input->ports[slot];
+
+        /* Pins that agree with their debounced level restart their count */
+        const uint8_t delta = (uint8_t)(hal_gpio_input_sample(port) ^ port->state);
+
+        port->count1 = (uint8_t)((port->count1 ^ port->count0) & delta);
+        port->count0 = (uint8_t)((uint8_t)(~port->count0) & delta);
+
+        /* The counter wrapped to zero: fourth sample in a row at the new level */
+        const uint8_t changed = (uint8_t)(delta & (uint8_t)(~(port->count0 | port->count1)));
+
+        if (changed != 0U)
+        {
+            port->state ^= changed;
+            hal_gpio_input_post(slot, changed);
+        }
+    }
+}
+
+bool HAL_GPIO_INPUT_Subscribe(hal_gpio_group_t pins, hal_gpio_edge_t edges, hal_gpio_input_callback_t callback)
+{
+    hal_gpio_input_t *input = &g_hal_gpio_input;
+
+    if ((callback == NULL) || (pins == 0U) || (((uint8_t)edges & (uint8_t)HAL_GPIO_EDGE_BOTH) == 0U) ||
+        (input->subscriber_count >= HAL_GPIO_INPUT_MAX_SUBSCRIBERS))
+    {
+        return false;
+    }
+
+    for (uint8_t idx = 0U; idx < HAL_GPIO_INPUT_GROUP_BITS; ++idx)
+    {
+        if ((pins & HAL_GPIO_GROUP_PIN(idx)) == 0U)
+        {
+            continue;
+        }
+
+        if ((idx >= g_hal_gpio_pinmap_count) || (input->pin_port[idx] == HAL_GPIO_INPUT_NO_PORT))
+        {
+            return false;
+        }
+    }
+
+    input->subscribers[input->subscriber_count].pins     = pins;
+    input->subscribers[input->subscriber_count].edges    = edges;
+    input->subscribers[input->subscriber_count].callback = callback;
+    input->subscriber_count++;
+
+    return true;
+}
+
+bool HAL_GPIO_INPUT_Read(hal_gpio_pin_id_t pin, hal_gpio_level_t *level)
+{
+    const hal_gpio_input_t *input = &g_hal_gpio_input;
+
+    if ((level == NULL) || !HAL_GPIO_IsValid(pin) || (input->pin_port[(uint8_t)pin] == HAL_GPIO_INPUT_NO_PORT))
+    {
+        return false;
+    }
+
+    const hal_gpio_input_port_t *port = &input->ports[input->pin_port[(uint8_t)pin]];
+
+    *level = ((port->state & g_hal_gpio_pinmap[(uint8_t)pin].mask) != 0U) ? HAL_GPIO_LEVEL_HIGH : HAL_GPIO_LEVEL_LOW;
+
+    return true;
+}
+
+void HAL_GPIO_INPUT_GetStats(hal_gpio_input_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = g_hal_gpio_input.stats;
+}
@@ -0,0 +1,233 @@
+#include "hal_i2c_bus_monitor.h"
+#include "hal_scheduler.h"
+#include "r_config_iica0.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#ifndef R_IICA0_LINE_SDA
+#define R_IICA0_LINE_SDA  (1U << 0)
+#endif
+#ifndef R_IICA0_LINE_SCL
+#define R_IICA0_LINE_SCL  (1U << 1)
+#endif
+
+#define HAL_I2C_BUS_LINES_IDLE  ((uint8_t)(R_IICA0_LINE_SDA | R_IICA0_LINE_SCL))
+
+typedef struct
+{
+    hal_i2c_bus_action_t floor;        /* lightest action the next recovery may use */
+    uint16_t             next_backoff_ms;
+    uint32_t             recovered_ms;
+    uint32_t             last_fault_ms;
+    uint8_t              event_id;     /* slave error event of the latest report */
+    bool                 pending;
+    hal_i2c_bus_stats_t  stats;
+} hal_i2c_bus_monitor_t;
+
+static hal_i2c_bus_monitor_t g_hal_i2c_bus_monitor;
+
+static hal_i2c_bus_action_t hal_i2c_bus_action_for(hal_i2c_bus_fault_t fault)
+{
+    hal_i2c_bus_action_t action;
+
+    switch (fault)
+    {
+        case HAL_I2C_BUS_FAULT_SDA_STUCK:
+            action = HAL_I2C_BUS_ACTION_PULSE;
+            break;
+        case HAL_I2C_BUS_FAULT_SCL_STUCK:
+            /* Pulses cannot help while something else drives SCL; often it is IICA0 itself */
+            action = HAL_I2C_BUS_ACTION_RESET;
+            break;
+        case HAL_I2C_BUS_FAULT_GLITCH:
+        case HAL_I2C_BUS_FAULT_NONE:
+        default:
+            action = HAL_I2C_BUS_ACTION_REARM;
+            break;
+    }
+
+    return action;
+}
+
+static void hal_i2c_bus_perform(hal_i2c_bus_action_t action)
+{
+    switch (action)
+    {
+        case HAL_I2C_BUS_ACTION_RESET:
+            R_Config_IICA0_ResetPeripheral();
+            R_Config_IICA0_ResetBusLines();
+            HAL_I2C_S_Reset();
+            break;
+        case HAL_I2C_BUS_ACTION_PULSE:
+            R_Config_IICA0_ResetBusLines();
+            HAL_I2C_S_Reset();
+            break;
+        case HAL_I2C_BUS_ACTION_REARM:
+            /* Usually already done by the slave ISR for this very event */
+            (void)HAL_I2C_S_RecoverEvent(g_hal_i2c_bus_monitor.event_id, HAL_I2C_RECOVERY_MEDIUM);
+            break;
+        case HAL_I2C_BUS_ACTION_NONE:
+        case HAL_I2C_BUS_ACTION_COUNT:
+        default:
+            break;
+    }
+}
+
+static bool hal_i2c_bus_holding(uint32_t now_ms)
+{
+    const hal_i2c_bus_monitor_t *monitor = &g_hal_i2c_bus_monitor;
+
+    return (monitor->stats.last_action != HAL_I2C_BUS_ACTION_NONE) &&
+           ((uint32_t)(now_ms - monitor->recovered_ms) < monitor->stats.backoff_ms);
+}
+
+static void hal_i2c_bus_recover(void)
+{
+    hal_i2c_bus_monitor_t *monitor = &g_hal_i2c_bus_monitor;
+    hal_i2c_bus_fault_t fault = HAL_I2C_BUS_Classify();
+
+    if (fault == HAL_I2C_BUS_FAULT_NONE)
+    {
+        fault = HAL_I2C_BUS_FAULT_GLITCH;
+    }
+
+    hal_i2c_bus_action_t action = hal_i2c_bus_action_for(fault);
+
+    if (action < monitor->floor)
+    {
+        action = monitor->floor;
+    }
+
+    const uint32_t started_us = HAL_SCHED_GetUptimeUs();
+
+    hal_i2c_bus_perform(action);
+
+    const uint32_t elapsed_us = (uint32_t)(HAL_SCHED_GetUptimeUs() - started_us);
+
+    monitor->stats.last_recovery_us = elapsed_us;
+    if (elapsed_us > monitor->stats.max_recovery_us)
+    {
+        monitor->stats.max_recovery_us = elapsed_us;
+    }
+    monitor->stats.actions[action]++;
+    monitor->stats.last_fault  = fault;
+    monitor->stats.last_action = action;
+    monitor->stats.lines_idle  = (HAL_I2C_BUS_Classify() == HAL_I2C_BUS_FAULT_NONE);
+
+    /* If this does not hold, the next attempt starts one level up after a longer wait */
+    monitor->floor = (action < HAL_I2C_BUS_ACTION_RESET) ? (hal_i2c_bus_action_t)(action + 1) : HAL_I2C_BUS_ACTION_RESET;
+    monitor->stats.backoff_ms = monitor->next_backoff_ms;
+    monitor->next_backoff_ms  = (monitor->next_backoff_ms < (HAL_I2C_BUS_BACKOFF_MAX_MS / 2U))
+                                    ? (uint16_t)(monitor->next_backoff_ms * 2U)
+                                    : (uint16_t)HAL_I2C_BUS_BACKOFF_MAX_MS;
+    monitor->recovered_ms = HAL_SCHED_GetUptimeMs();
+    monitor->pending      = false;
+
+    /* A line still held low counts as an ongoing fault for the quiet period */
+    if (!monitor->stats.lines_idle)
+    {
+        monitor->last_fault_ms = monitor->recovered_ms;
+    }
+}
+
+void HAL_I2C_BUS_Init(void)
+{
+    hal_i2c_bus_monitor_t *monitor = &g_hal_i2c_bus_monitor;
+
+    (void)memset(monitor, 0, sizeof *monitor);
+    monitor->floor           = HAL_I2C_BUS_ACTION_REARM;
+    monitor->next_backoff_ms = (uint16_t)HAL_I2C_BUS_BACKOFF_MIN_MS;
+    monitor->stats.lines_idle = true;
+}
+
+hal_i2c_bus_fault_t HAL_I2C_BUS_Classify(void)
+{
+    const uint32_t started_us = HAL_SCHED_GetUptimeUs();
+    uint8_t lines = 0U;
+    uint8_t samples = 0U;
+    hal_i2c_bus_fault_t fault = HAL_I2C_BUS_FAULT_NONE;
+
+    /* A line seen high once is not stuck; one low sample may be a clock phase */
+    do
+    {
+        lines |= R_Config_IICA0_SampleBusLines();
+        if (samples < UINT8_MAX)
+        {
+            samples++;
+        }
+    } while ((lines != HAL_I2C_BUS_LINES_IDLE) &&
+             ((samples < HAL_I2C_BUS_STUCK_SAMPLES) ||
+              ((uint32_t)(HAL_SCHED_GetUptimeUs() - started_us) < HAL_I2C_BUS_STUCK_WINDOW_US)));
+
+    if ((lines & R_IICA0_LINE_SCL) == 0U)
+    {
+        fault = HAL_I2C_BUS_FAULT_SCL_STUCK;
+    }
+    else if ((lines & R_IICA0_LINE_SDA) == 0U)
+    {
+        fault = HAL_I2C_BUS_FAULT_SDA_STUCK;
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    return fault;
+}
+
+void HAL_I2C_BUS_ReportFault(hal_i2c_error_t code, uint8_t event_id)
+{
+    hal_i2c_bus_monitor_t *monitor = &g_hal_i2c_bus_monitor;
+    const uint32_t now_ms = HAL_SCHED_GetUptimeMs();
+
+    (void)code;
+    monitor->stats.faults++;
+    monitor->event_id = event_id;
+
+    if ((monitor->stats.last_action != HAL_I2C_BUS_ACTION_NONE) &&
+        ((uint32_t)(now_ms - monitor->last_fault_ms) >= HAL_I2C_BUS_HEALTHY_MS))
+    {
+        monitor->floor           = HAL_I2C_BUS_ACTION_REARM;
+        monitor->next_backoff_ms = (uint16_t)HAL_I2C_BUS_BACKOFF_MIN_MS;
+    }
+    else
+    {
+        /* No action required */
+    }
+    monitor->last_fault_ms = now_ms;
+
+    /* The slave already dropped the frame; heavier recovery waits its turn */
+    if (monitor->pending || hal_i2c_bus_holding(now_ms))
+    {
+        monitor->pending = true;
+        monitor->stats.deferred++;
+        return;
+    }
+
+    hal_i2c_bus_recover();
+}
+
+void HAL_I2C_BUS_Task(void)
+{
+    const hal_i2c_bus_monitor_t *monitor = &g_hal_i2c_bus_monitor;
+
+    if ((monitor->pending || !monitor->stats.lines_idle) && !hal_i2c_bus_holding(HAL_SCHED_GetUptimeMs()))
+    {
+        hal_i2c_bus_recover();
+    }
+    else
+    {
+        /* No action required */
+    }
+}
+
+void HAL_I2C_BUS_GetStats(hal_i2c_bus_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = g_hal_i2c_bus_monitor.stats;
+}
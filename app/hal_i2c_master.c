@@ -1,4 +1,7 @@
 #include "hal_i2c_master.h"
+#include "hal_critical.h"
+#include "hal_gpio.h"
+#include "hal_scheduler.h"
 
 #include "r_cg_macrodriver.h"
 #include "r_config_iica0.h"
@@ -9,24 +12,105 @@
 #define HAL_I2C_MASTER_SCL_MASK   (uint8_t)(1U << 1)
 #define HAL_I2C_MASTER_SDA_MASK   (uint8_t)(1U << 0)
 #define HAL_I2C_MASTER_PINS_MASK  (uint8_t)(HAL_I2C_MASTER_SCL_MASK | HAL_I2C_MASTER_SDA_MASK)
-#define HAL_I2C_MASTER_DELAY_CYCLES UINT16_C(200)
-#define HAL_I2C_MASTER_MAX_ACK_POLL_ATTEMPTS (100U)
 
-typedef struct
-{
-    uint8_t p6;
-    uint8_t pm6;
-#if defined(PMC6)
-    uint8_t pmc6;
+/*
+ * Cycle cost of one hal_i2c_master_delay iteration and the fixed cost of the
+ * pin writes and calls around each delay; both only shorten the loop count so
+ * the bus never runs faster than the selected mode.
+ */
+#ifndef HAL_I2C_MASTER_DELAY_LOOP_CYCLES
+#define HAL_I2C_MASTER_DELAY_LOOP_CYCLES      (8UL)
 #endif
-#if defined(PU6)
-    uint8_t pu6;
+#ifndef HAL_I2C_MASTER_DELAY_OVERHEAD_CYCLES
+#define HAL_I2C_MASTER_DELAY_OVERHEAD_CYCLES  (24UL)
+#endif
+#define HAL_I2C_MASTER_STRETCH_POLL_CYCLES    (10UL)
+
+/*
+ * Host builds route busy-wait time and pin reads through a virtual port so
+ * the generated waveform can be checked; on target both are plain code. A
+ * zero-cycle elapse after each pin write lets the port log every
+ * intermediate state, not just the one reached before the next delay.
+ */
+#ifndef HAL_I2C_MASTER_ELAPSE
+#define HAL_I2C_MASTER_ELAPSE(cycles)  ((void)0)
+#endif
+#ifndef HAL_I2C_MASTER_READ_PORT
+#define HAL_I2C_MASTER_READ_PORT()     (P6)
 #endif
-} hal_i2c_master_port_snapshot_t;
 
-static void hal_i2c_master_delay(uint16_t cycles)
+#define HAL_I2C_MASTER_NS_TO_CYCLES(ns) \
+    ((((ns) * (HAL_I2C_M_CPU_HZ / 1000UL)) + 999999UL) / 1000000UL)
+#define HAL_I2C_MASTER_NS_TO_LOOPS(ns)                                                          \
+    ((HAL_I2C_MASTER_NS_TO_CYCLES(ns) > HAL_I2C_MASTER_DELAY_OVERHEAD_CYCLES)                   \
+         ? (((HAL_I2C_MASTER_NS_TO_CYCLES(ns) - HAL_I2C_MASTER_DELAY_OVERHEAD_CYCLES)           \
+             + (HAL_I2C_MASTER_DELAY_LOOP_CYCLES - 1UL)) / HAL_I2C_MASTER_DELAY_LOOP_CYCLES)     \
+         : 0UL)
+
+#if HAL_I2C_MASTER_NS_TO_LOOPS(4700UL) > 0xFFFFUL
+#error "HAL_I2C_M_CPU_HZ too high for 16-bit delay loops"
+#endif
+
+/* ACK polling after tWR: first gap, doubled per NACK up to the cap */
+#define HAL_I2C_MASTER_POLL_GAP_MIN_US  (100UL)
+#define HAL_I2C_MASTER_POLL_GAP_MAX_US  (1600UL)
+
+typedef struct
 {
-    volatile uint16_t counter = cycles;
+    const hal_i2c_m_eeprom_t           *device;
+    const uint8_t                      *data;
+    hal_i2c_m_fill_fn_t                 producer;   /* used when data is NULL */
+    void                               *producer_context;
+    uint32_t                            memory_address;
+    uint32_t                            length;
+    uint32_t                            offset;
+    uint32_t                            write_done_us;
+    uint32_t                            next_poll_us;  /* relative to write_done_us */
+    uint32_t                            poll_gap_us;
+    hal_i2c_m_callback_t                callback;   /* asynchronous jobs only */
+    void                               *callback_context;
+    volatile hal_i2c_m_eeprom_status_t  status;
+} hal_i2c_master_eeprom_job_t;
+
+#define HAL_I2C_M_EEPROM_DEFINE_ENTRY(name, address7, part) HAL_I2C_M_EEPROM_PART_##part(address7),
+const hal_i2c_m_eeprom_t g_hal_i2c_m_eeprom_table[] = {
+    HAL_I2C_M_EEPROM_TABLE(HAL_I2C_M_EEPROM_DEFINE_ENTRY)
+};
+#undef HAL_I2C_M_EEPROM_DEFINE_ENTRY
+
+static hal_i2c_master_eeprom_job_t g_hal_i2c_master_eeprom_job;
+/* Address header plus one page program; transfers never overlap */
+static uint8_t g_hal_i2c_master_eeprom_payload[HAL_I2C_M_EEPROM_MAX_PAGE_SIZE + 2U];
+static uint32_t g_hal_i2c_master_eeprom_last_write_us = 0UL;
+static uint32_t g_hal_i2c_master_eeprom_max_write_us = 0UL;
+
+typedef struct
+{
+    hal_i2c_m_txn_t      txn;
+    hal_i2c_m_callback_t callback;
+} hal_i2c_master_queue_slot_t;
+
+/*
+ * Submitted from thread context, retired from the completion callback (ISR
+ * context with IICA1). head is the transaction on the wire while active.
+ */
+typedef struct
+{
+    hal_i2c_master_queue_slot_t slots[HAL_I2C_M_QUEUE_DEPTH];
+    volatile uint8_t            head;
+    volatile uint8_t            count;
+    volatile bool               active;
+} hal_i2c_master_queue_t;
+
+static hal_i2c_master_queue_t g_hal_i2c_master_queue;
+
+#if HAL_I2C_M_BACKEND == HAL_I2C_M_BACKEND_GPIO
+
+static void hal_i2c_master_delay(uint16_t loops)
+{
+    volatile uint16_t counter = loops;
+
+    HAL_I2C_MASTER_ELAPSE(HAL_I2C_MASTER_DELAY_OVERHEAD_CYCLES + ((uint32_t)loops * HAL_I2C_MASTER_DELAY_LOOP_CYCLES));
 
     while (counter-- != 0U)
     {
@@ -34,52 +118,113 @@ static void hal_i2c_master_delay(uint16_t cycles)
     }
 }
 
+#if defined(PU6)
+#define HAL_I2C_MASTER_PU_REG   (&PU6)
+#else
+#define HAL_I2C_MASTER_PU_REG   (NULL)
+#endif
+#if defined(PMC6)
+#define HAL_I2C_MASTER_PMC_REG  (&PMC6)
+#else
+#define HAL_I2C_MASTER_PMC_REG  (NULL)
+#endif
+
+static const hal_gpio_port_pins_t g_hal_i2c_master_pins = {
+    &P6, &PM6, HAL_I2C_MASTER_PU_REG, HAL_I2C_MASTER_PMC_REG, HAL_I2C_MASTER_PINS_MASK
+};
+
+/* Loop counts per phase, from the UM10204 minimums for each mode */
+typedef struct
+{
+    uint16_t low_loops;   /* tLOW, also tBUF and data setup while SCL is low */
+    uint16_t high_loops;  /* tHIGH, also tSU;STA, tHD;STA and tSU;STO */
+} hal_i2c_master_timing_t;
+
+static const hal_i2c_master_timing_t g_hal_i2c_master_timings[HAL_I2C_M_SPEED_COUNT] = {
+    { (uint16_t)HAL_I2C_MASTER_NS_TO_LOOPS(4700UL), (uint16_t)HAL_I2C_MASTER_NS_TO_LOOPS(4000UL) },
+    { (uint16_t)HAL_I2C_MASTER_NS_TO_LOOPS(1300UL), (uint16_t)HAL_I2C_MASTER_NS_TO_LOOPS(600UL) },
+    { (uint16_t)HAL_I2C_MASTER_NS_TO_LOOPS(500UL),  (uint16_t)HAL_I2C_MASTER_NS_TO_LOOPS(260UL) }
+};
+
+#define HAL_I2C_MASTER_STRETCH_LIMIT \
+    ((HAL_I2C_M_STRETCH_TIMEOUT_US * (HAL_I2C_M_CPU_HZ / 1000000UL)) / HAL_I2C_MASTER_STRETCH_POLL_CYCLES)
+
+static const hal_i2c_master_timing_t *g_hal_i2c_master_timing = &g_hal_i2c_master_timings[HAL_I2C_M_DEFAULT_SPEED];
+static hal_i2c_m_speed_t g_hal_i2c_master_speed = HAL_I2C_M_DEFAULT_SPEED;
+static bool g_hal_i2c_master_stretch_fault = false;
+static hal_gpio_port_snapshot_t g_hal_i2c_master_session_snapshot;
+static uint8_t g_hal_i2c_master_session_depth = 0U;
+
+static bool hal_i2c_master_read_scl(void)
+{
+    return ((HAL_I2C_MASTER_READ_PORT() & HAL_I2C_MASTER_SCL_MASK) != 0U);
+}
+
 static void hal_i2c_master_release_scl(void)
 {
+    uint32_t polls = 0UL;
+
     PM6 |= HAL_I2C_MASTER_SCL_MASK;
+    HAL_I2C_MASTER_ELAPSE(0U);
+
+    /* A slave may hold SCL low after we let go; the high phase starts when it lets go too */
+    while (!hal_i2c_master_read_scl() && !g_hal_i2c_master_stretch_fault)
+    {
+        HAL_I2C_MASTER_ELAPSE(HAL_I2C_MASTER_STRETCH_POLL_CYCLES);
+        if (++polls >= HAL_I2C_MASTER_STRETCH_LIMIT)
+        {
+            g_hal_i2c_master_stretch_fault = true;
+        }
+    }
 }
 
 static void hal_i2c_master_release_sda(void)
 {
     PM6 |= HAL_I2C_MASTER_SDA_MASK;
+    HAL_I2C_MASTER_ELAPSE(0U);
 }
 
 static void hal_i2c_master_drive_scl_low(void)
 {
     P6 &= (uint8_t)(~HAL_I2C_MASTER_SCL_MASK);
+    HAL_I2C_MASTER_ELAPSE(0U);
     PM6 &= (uint8_t)(~HAL_I2C_MASTER_SCL_MASK);
+    HAL_I2C_MASTER_ELAPSE(0U);
 }
 
 static void hal_i2c_master_drive_sda_low(void)
 {
     P6 &= (uint8_t)(~HAL_I2C_MASTER_SDA_MASK);
+    HAL_I2C_MASTER_ELAPSE(0U);
     PM6 &= (uint8_t)(~HAL_I2C_MASTER_SDA_MASK);
+    HAL_I2C_MASTER_ELAPSE(0U);
 }
 
 static bool hal_i2c_master_read_sda(void)
 {
-    return ((P6 & HAL_I2C_MASTER_SDA_MASK) != 0U);
+    return ((HAL_I2C_MASTER_READ_PORT() & HAL_I2C_MASTER_SDA_MASK) != 0U);
 }
 
 static void hal_i2c_master_start_condition(void)
 {
     hal_i2c_master_release_sda();
+    hal_i2c_master_delay(g_hal_i2c_master_timing->low_loops);
     hal_i2c_master_release_scl();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->high_loops);
 
     hal_i2c_master_drive_sda_low();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->high_loops);
     hal_i2c_master_drive_scl_low();
 }
 
 static void hal_i2c_master_stop_condition(void)
 {
     hal_i2c_master_drive_sda_low();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->low_loops);
     hal_i2c_master_release_scl();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->high_loops);
     hal_i2c_master_release_sda();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->low_loops);
 }
 
 static void hal_i2c_master_write_bit(bool bit)
@@ -93,18 +238,18 @@ static void hal_i2c_master_write_bit(bool bit)
         hal_i2c_master_drive_sda_low();
     }
 
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->low_loops);
     hal_i2c_master_release_scl();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->high_loops);
     hal_i2c_master_drive_scl_low();
 }
 
 static bool hal_i2c_master_read_bit(void)
 {
     hal_i2c_master_release_sda();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->low_loops);
     hal_i2c_master_release_scl();
-    hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+    hal_i2c_master_delay(g_hal_i2c_master_timing->high_loops);
     const bool high = hal_i2c_master_read_sda();
     hal_i2c_master_drive_scl_low();
 
@@ -118,7 +263,8 @@ static bool hal_i2c_master_write_byte(uint8_t value)
         hal_i2c_master_write_bit((value & mask) != 0U);
     }
 
-    const bool ack = (hal_i2c_master_read_bit() == false);
+    /* A stuck clock reads back as NACK so callers stop and send a stop */
+    const bool ack = (hal_i2c_master_read_bit() == false) && !g_hal_i2c_master_stretch_fault;
 
     return ack;
 }
@@ -150,7 +296,7 @@ static uint8_t hal_i2c_master_normalize_address(uint8_t address)
     return (uint8_t)(address & UINT8_C(0x7F));
 }
 
-static bool hal_i2c_master_acquire_bus(hal_i2c_master_port_snapshot_t *snapshot)
+static bool hal_i2c_master_acquire_bus(hal_gpio_port_snapshot_t *snapshot)
 {
     if (snapshot == NULL)
     {
@@ -158,114 +304,121 @@ static bool hal_i2c_master_acquire_bus(hal_i2c_master_port_snapshot_t *snapshot)
     }
 
     R_Config_IICA0_Stop();
-
-    snapshot->p6  = P6;
-    snapshot->pm6 = PM6;
-#if defined(PMC6)
-    snapshot->pmc6 = PMC6;
-#endif
-#if defined(PU6)
-    snapshot->pu6 = PU6;
-#endif
-
-    P6  |= HAL_I2C_MASTER_PINS_MASK;
-    PM6 |= HAL_I2C_MASTER_PINS_MASK;
-#if defined(PU6)
-    PU6 |= HAL_I2C_MASTER_PINS_MASK;
-#endif
-#if defined(PMC6)
-    PMC6 &= (uint8_t)(~HAL_I2C_MASTER_PINS_MASK);
-#endif
+    HAL_GPIO_ClaimPins(&g_hal_i2c_master_pins, snapshot);
 
     return true;
 }
 
-static void hal_i2c_master_release_bus(const hal_i2c_master_port_snapshot_t *snapshot)
+static void hal_i2c_master_release_bus(const hal_gpio_port_snapshot_t *snapshot)
 {
     if (snapshot == NULL)
     {
         return;
     }
 
-#if defined(PU6)
-    PU6 = (uint8_t)((PU6 & (uint8_t)(~HAL_I2C_MASTER_PINS_MASK)) | (snapshot->pu6 & HAL_I2C_MASTER_PINS_MASK));
-#endif
-#if defined(PMC6)
-    PMC6 = (uint8_t)((PMC6 & (uint8_t)(~HAL_I2C_MASTER_PINS_MASK)) | (snapshot->pmc6 & HAL_I2C_MASTER_PINS_MASK));
-#endif
-    P6  = (uint8_t)((P6 & (uint8_t)(~HAL_I2C_MASTER_PINS_MASK)) | (snapshot->p6 & HAL_I2C_MASTER_PINS_MASK));
-    PM6 = (uint8_t)((PM6 & (uint8_t)(~HAL_I2C_MASTER_PINS_MASK)) | (snapshot->pm6 & HAL_I2C_MASTER_PINS_MASK));
+    HAL_GPIO_RestorePins(&g_hal_i2c_master_pins, snapshot);
 
     R_Config_IICA0_Create();
     R_Config_IICA0_Start();
     R_Config_IICA0_SlaveReceiveStart();
 }
 
-static bool hal_i2c_master_poll_ack(uint8_t address)
+bool HAL_I2C_M_BeginSession(void)
 {
-    hal_i2c_master_port_snapshot_t snapshot;
-
-    if (!hal_i2c_master_acquire_bus(&snapshot))
+    if (g_hal_i2c_master_session_depth == UINT8_MAX)
     {
         return false;
     }
 
-    const uint8_t write_address = (uint8_t)((hal_i2c_master_normalize_address(address) << 1) | 0U);
-    bool acknowledged = false;
-
-    hal_i2c_master_start_condition();
-    acknowledged = hal_i2c_master_write_byte(write_address);
-    hal_i2c_master_stop_condition();
+    if (g_hal_i2c_master_session_depth == 0U)
+    {
+        if (!hal_i2c_master_acquire_bus(&g_hal_i2c_master_session_snapshot))
+        {
+            return false;
+        }
+    }
 
-    hal_i2c_master_release_bus(&snapshot);
+    g_hal_i2c_master_session_depth++;
+    /* A stuck clock only fails the transfer it happened in */
+    g_hal_i2c_master_stretch_fault = false;
 
-    return acknowledged;
+    return true;
 }
 
-bool HAL_I2C_M_Write(uint8_t address, const uint8_t *data, uint16_t length)
+void HAL_I2C_M_EndSession(void)
 {
-    if ((data == NULL) || (length == 0U))
+    if (g_hal_i2c_master_session_depth == 0U)
     {
-        return false;
+        return;
     }
 
-    return HAL_I2C_M_WriteRead(address, data, length, NULL, 0U);
+    g_hal_i2c_master_session_depth--;
+    if (g_hal_i2c_master_session_depth == 0U)
+    {
+        hal_i2c_master_release_bus(&g_hal_i2c_master_session_snapshot);
+    }
 }
 
-bool HAL_I2C_M_Read(uint8_t address, uint8_t *data, uint16_t length)
+bool HAL_I2C_M_Probe(uint8_t address)
 {
-    if ((data == NULL) || (length == 0U))
+    if (!HAL_I2C_M_BeginSession())
     {
         return false;
     }
 
-    return HAL_I2C_M_WriteRead(address, NULL, 0U, data, length);
+    const uint8_t write_address = (uint8_t)((hal_i2c_master_normalize_address(address) << 1) | 0U);
+    bool acknowledged = false;
+
+    hal_i2c_master_start_condition();
+    acknowledged = hal_i2c_master_write_byte(write_address);
+    hal_i2c_master_stop_condition();
+
+    const bool success = acknowledged && !g_hal_i2c_master_stretch_fault;
+
+    HAL_I2C_M_EndSession();
+
+    return success;
 }
 
-bool HAL_I2C_M_WriteRead(uint8_t address,
-                              const uint8_t *tx_data,
-                              uint16_t tx_length,
-                              uint8_t *rx_data,
-                              uint16_t rx_length)
+void HAL_I2C_M_Init(void)
 {
-    if ((tx_length == 0U) && (rx_length == 0U))
-    {
-        return false;
-    }
+    /* Pins are only taken over for the duration of a transfer */
+    (void)HAL_I2C_M_SetBusSpeed(HAL_I2C_M_DEFAULT_SPEED);
+}
 
-    if ((tx_length > 0U) && (tx_data == NULL))
+bool HAL_I2C_M_SetBusSpeed(hal_i2c_m_speed_t speed)
+{
+    if (speed >= HAL_I2C_M_SPEED_COUNT)
     {
         return false;
     }
 
-    if ((rx_length > 0U) && (rx_data == NULL))
-    {
-        return false;
-    }
+    g_hal_i2c_master_speed  = speed;
+    g_hal_i2c_master_timing = &g_hal_i2c_master_timings[speed];
+
+    return true;
+}
 
-    hal_i2c_master_port_snapshot_t snapshot;
+hal_i2c_m_speed_t HAL_I2C_M_GetBusSpeed(void)
+{
+    return g_hal_i2c_master_speed;
+}
 
-    if (!hal_i2c_master_acquire_bus(&snapshot))
+/*
+ * Write phase, then a read phase of rx_length bytes through an rx_size
+ * buffer. With a consumer the buffer is handed over each time it fills while
+ * the bus is held with SCL low; without one rx_size equals rx_length.
+ */
+static bool hal_i2c_master_transfer(uint8_t address,
+                                    const uint8_t *tx_data,
+                                    uint16_t tx_length,
+                                    uint8_t *rx_data,
+                                    uint16_t rx_size,
+                                    uint32_t rx_length,
+                                    hal_i2c_m_chunk_fn_t consumer,
+                                    void *context)
+{
+    if (!HAL_I2C_M_BeginSession())
     {
         return false;
     }
@@ -304,99 +457,747 @@ bool HAL_I2C_M_WriteRead(uint8_t address,
         }
         else
         {
-            for (uint16_t index = 0U; index < rx_length; index++)
+            uint32_t remaining = rx_length;
+            uint16_t fill = 0U;
+
+            while (remaining > 0U)
             {
-                const bool acknowledge = (index + 1U) < rx_length;
-                rx_data[index] = hal_i2c_master_read_byte(acknowledge);
+                const bool acknowledge = remaining > 1U;
+                rx_data[fill] = hal_i2c_master_read_byte(acknowledge);
+                fill++;
+                remaining--;
+
+                /* SCL is stuck: the byte is garbage and so is everything after it */
+                if (g_hal_i2c_master_stretch_fault)
+                {
+                    success = false;
+                    break;
+                }
+
+                if ((consumer != NULL) && ((fill == rx_size) || (remaining == 0U)))
+                {
+                    if (!consumer(rx_data, fill, context))
+                    {
+                        success = false;
+                        if (remaining > 0U)
+                        {
+                            /* The last byte was ACKed; a NACKed one ends the slave's read */
+                            (void)hal_i2c_master_read_byte(false);
+                        }
+                        remaining = 0U;
+                    }
+                    fill = 0U;
+                }
             }
         }
     }
 
     hal_i2c_master_stop_condition();
-    hal_i2c_master_release_bus(&snapshot);
+    success = success && !g_hal_i2c_master_stretch_fault;
+    HAL_I2C_M_EndSession();
 
     return success;
 }
 
-static bool hal_i2c_master_eeprom_wait_ready(void)
+bool HAL_I2C_M_WriteRead(uint8_t address,
+                              const uint8_t *tx_data,
+                              uint16_t tx_length,
+                              uint8_t *rx_data,
+                              uint16_t rx_length)
 {
-    uint32_t attempts = 0U;
-    bool ready = false;
+    if ((tx_length == 0U) && (rx_length == 0U))
+    {
+        return false;
+    }
+
+    if ((tx_length > 0U) && (tx_data == NULL))
+    {
+        return false;
+    }
+
+    if ((rx_length > 0U) && (rx_data == NULL))
+    {
+        return false;
+    }
+
+    return hal_i2c_master_transfer(address, tx_data, tx_length, rx_data, rx_length, rx_length, NULL, NULL);
+}
+
+bool HAL_I2C_M_WriteReadStream(uint8_t address,
+                               const uint8_t *tx_data,
+                               uint16_t tx_length,
+                               uint32_t rx_length,
+                               uint8_t *chunk,
+                               uint16_t chunk_size,
+                               hal_i2c_m_chunk_fn_t consumer,
+                               void *context)
+{
+    if ((rx_length == 0U) || (chunk == NULL) || (chunk_size == 0U) || (consumer == NULL))
+    {
+        return false;
+    }
+
+    if ((tx_length > 0U) && (tx_data == NULL))
+    {
+        return false;
+    }
+
+    return hal_i2c_master_transfer(address, tx_data, tx_length, chunk, chunk_size, rx_length, consumer, context);
+}
+
+bool HAL_I2C_M_WriteReadAsync(uint8_t address,
+                              const uint8_t *tx_data,
+                              uint16_t tx_length,
+                              uint8_t *rx_data,
+                              uint16_t rx_length,
+                              hal_i2c_m_callback_t callback,
+                              void *context)
+{
+    if ((tx_length == 0U) && (rx_length == 0U))
+    {
+        return false;
+    }
+
+    if (((tx_length > 0U) && (tx_data == NULL)) || ((rx_length > 0U) && (rx_data == NULL)))
+    {
+        return false;
+    }
+
+    /* Bit-banged transfers complete before returning; failures reach the callback */
+    const bool success = HAL_I2C_M_WriteRead(address, tx_data, tx_length, rx_data, rx_length);
+
+    if (callback != NULL)
+    {
+        callback(success, context);
+    }
+
+    return true;
+}
+
+bool HAL_I2C_M_IsBusy(void)
+{
+    return false;
+}
+
+void HAL_I2C_M_OnInterrupt(void)
+{
+    /* No interrupt source for the GPIO backend */
+}
+
+#endif /* HAL_I2C_M_BACKEND == HAL_I2C_M_BACKEND_GPIO */
+
+bool HAL_I2C_M_Write(uint8_t address, const uint8_t *data, uint16_t length)
+{
+    if ((data == NULL) || (length == 0U))
+    {
+        return false;
+    }
+
+    return HAL_I2C_M_WriteRead(address, data, length, NULL, 0U);
+}
+
+bool HAL_I2C_M_Read(uint8_t address, uint8_t *data, uint16_t length)
+{
+    if ((data == NULL) || (length == 0U))
+    {
+        return false;
+    }
+
+    return HAL_I2C_M_WriteRead(address, NULL, 0U, data, length);
+}
+
+bool HAL_I2C_M_WriteAsync(uint8_t address,
+                          const uint8_t *data,
+                          uint16_t length,
+                          hal_i2c_m_callback_t callback,
+                          void *context)
+{
+    if ((data == NULL) || (length == 0U))
+    {
+        return false;
+    }
+
+    return HAL_I2C_M_WriteReadAsync(address, data, length, NULL, 0U, callback, context);
+}
+
+bool HAL_I2C_M_ReadAsync(uint8_t address,
+                         uint8_t *data,
+                         uint16_t length,
+                         hal_i2c_m_callback_t callback,
+                         void *context)
+{
+    if ((data == NULL) || (length == 0U))
+    {
+        return false;
+    }
+
+    return HAL_I2C_M_WriteReadAsync(address, NULL, 0U, data, length, callback, context);
+}
+
+static void hal_i2c_master_queue_start_next(void);
+
+static void hal_i2c_master_queue_complete(bool success, void *context)
+{
+    hal_i2c_master_queue_t *queue = &g_hal_i2c_master_queue;
+    const hal_i2c_master_queue_slot_t *slot = &queue->slots[queue->head];
+    const hal_i2c_m_callback_t callback = slot->callback;
+    void *txn_context = slot->txn.context;
+    hal_critical_state_t state;
+
+    (void)context;
+
+    HAL_CRITICAL_ENTER(state);
+    queue->head   = (uint8_t)((queue->head + 1U) % HAL_I2C_M_QUEUE_DEPTH);
+    queue->count  = (uint8_t)(queue->count - 1U);
+    queue->active = false;
+    HAL_CRITICAL_EXIT(state);
+
+    if (callback != NULL)
+    {
+        callback(success, txn_context);
+    }
+
+#if HAL_I2C_M_BACKEND == HAL_I2C_M_BACKEND_IICA1
+    /* Keep the bus busy without waiting for the next service call */
+    hal_i2c_master_queue_start_next();
+#endif
+}
+
+static void hal_i2c_master_queue_start_next(void)
+{
+    hal_i2c_master_queue_t *queue = &g_hal_i2c_master_queue;
+    hal_critical_state_t state;
+    bool claimed = false;
+
+    HAL_CRITICAL_ENTER(state);
+    if (!queue->active && (queue->count > 0U))
+    {
+        queue->active = true;
+        claimed = true;
+    }
+    HAL_CRITICAL_EXIT(state);
+
+    if (!claimed)
+    {
+        return;
+    }
+
+    const hal_i2c_m_txn_t *txn = &queue->slots[queue->head].txn;
+
+    if (!HAL_I2C_M_WriteReadAsync(txn->address,
+                                  txn->tx_data,
+                                  txn->tx_length,
+                                  txn->rx_data,
+                                  txn->rx_length,
+                                  hal_i2c_master_queue_complete,
+                                  NULL))
+    {
+        /* Bus or peripheral busy: leave it at the head for the next service call */
+        queue->active = false;
+    }
+}
+
+bool HAL_I2C_M_Submit(const hal_i2c_m_txn_t *txn, hal_i2c_m_callback_t callback)
+{
+    hal_i2c_master_queue_t *queue = &g_hal_i2c_master_queue;
+    hal_critical_state_t state;
+    bool accepted = false;
+
+    if ((txn == NULL) || ((txn->tx_length == 0U) && (txn->rx_length == 0U)))
+    {
+        return false;
+    }
+
+    if (((txn->tx_length > 0U) && (txn->tx_data == NULL)) ||
+        ((txn->rx_length > 0U) && (txn->rx_data == NULL)))
+    {
+        return false;
+    }
+
+    HAL_CRITICAL_ENTER(state);
+    if (queue->count < HAL_I2C_M_QUEUE_DEPTH)
+    {
+        const uint8_t tail = (uint8_t)((queue->head + queue->count) % HAL_I2C_M_QUEUE_DEPTH);
+
+        queue->slots[tail].txn      = *txn;
+        queue->slots[tail].callback = callback;
+        queue->count = (uint8_t)(queue->count + 1U);
+        accepted = true;
+    }
+    HAL_CRITICAL_EXIT(state);
+
+#if HAL_I2C_M_BACKEND == HAL_I2C_M_BACKEND_IICA1
+    if (accepted)
+    {
+        hal_i2c_master_queue_start_next();
+    }
+#endif
+
+    return accepted;
+}
+
+uint8_t HAL_I2C_M_GetPendingCount(void)
+{
+    return g_hal_i2c_master_queue.count;
+}
+
+void HAL_I2C_M_Service(void)
+{
+    hal_i2c_master_queue_start_next();
+}
 
-    while ((attempts < HAL_I2C_MASTER_MAX_ACK_POLL_ATTEMPTS) && !ready)
+static bool hal_i2c_master_eeprom_valid(const hal_i2c_m_eeprom_t *device,
+                                       uint32_t memory_address,
+                                       uint32_t length)
+{
+    if ((device == NULL) || (length == 0U) || (device->page_size == 0U))
     {
-        ready = hal_i2c_master_poll_ack(HAL_I2C_M_EEPROM_DEVICE_ADDRESS7);
-        if (!ready)
+        return false;
+    }
+
+    if ((device->address_bytes != 1U) && (device->address_bytes != 2U))
+    {
+        return false;
+    }
+
+    return (memory_address < device->size_bytes) && (length <= (device->size_bytes - memory_address));
+}
+
+/* Bytes addressable in-band before the block bits in the device address change */
+static uint32_t hal_i2c_master_eeprom_block_size(const hal_i2c_m_eeprom_t *device)
+{
+    return (uint32_t)1UL << (device->address_bytes * 8U);
+}
+
+/* Fills the in-band address bytes and returns the device address for memory_address */
+static uint8_t hal_i2c_master_eeprom_header(const hal_i2c_m_eeprom_t *device,
+                                            uint32_t memory_address,
+                                            uint8_t *header)
+{
+    const uint8_t block = (uint8_t)((memory_address >> (device->address_bytes * 8U)) & 0x07U);
+
+    if (device->address_bytes == 2U)
+    {
+        header[0] = (uint8_t)(memory_address >> 8);
+        header[1] = (uint8_t)(memory_address & 0xFFU);
+    }
+    else
+    {
+        header[0] = (uint8_t)(memory_address & 0xFFU);
+    }
+
+    return (uint8_t)(device->address7 | block);
+}
+
+static hal_i2c_m_speed_t hal_i2c_master_eeprom_select(const hal_i2c_m_eeprom_t *device)
+{
+    const hal_i2c_m_speed_t previous = HAL_I2C_M_GetBusSpeed();
+
+    if (device->max_speed != previous)
+    {
+        /* Refused while the IICA1 queue is on the wire; the current speed is then kept */
+        (void)HAL_I2C_M_SetBusSpeed(device->max_speed);
+    }
+
+    return previous;
+}
+
+static void hal_i2c_master_eeprom_restore(hal_i2c_m_speed_t previous)
+{
+    if (HAL_I2C_M_GetBusSpeed() != previous)
+    {
+        (void)HAL_I2C_M_SetBusSpeed(previous);
+    }
+}
+
+static void hal_i2c_master_eeprom_job_init(hal_i2c_master_eeprom_job_t *job,
+                                           const hal_i2c_m_eeprom_t *device,
+                                           uint32_t memory_address,
+                                           uint32_t length)
+{
+    (void)memset(job, 0, sizeof *job);
+    job->device         = device;
+    job->memory_address = memory_address;
+    job->length         = length;
+    job->status         = HAL_I2C_M_EEPROM_BUSY;
+}
+
+static void hal_i2c_master_eeprom_begin_wait(hal_i2c_master_eeprom_job_t *job)
+{
+    job->write_done_us = HAL_SCHED_GetUptimeUs();
+    job->next_poll_us  = job->device->write_cycle_us;
+    job->poll_gap_us   = HAL_I2C_MASTER_POLL_GAP_MIN_US;
+}
+
+/*
+ * No bus traffic until tWR has elapsed; after that one ACK poll per due
+ * time with a doubling gap. Marks the job FAILED after the write timeout.
+ */
+static bool hal_i2c_master_eeprom_poll_ready(hal_i2c_master_eeprom_job_t *job)
+{
+    const uint32_t elapsed_us = HAL_SCHED_GetUptimeUs() - job->write_done_us;
+
+    if (elapsed_us < job->next_poll_us)
+    {
+        return false;
+    }
+
+    const hal_i2c_m_speed_t previous = hal_i2c_master_eeprom_select(job->device);
+    const bool ready = HAL_I2C_M_Probe(job->device->address7);
+
+    hal_i2c_master_eeprom_restore(previous);
+
+    if (ready)
+    {
+        g_hal_i2c_master_eeprom_last_write_us = elapsed_us;
+        if (elapsed_us > g_hal_i2c_master_eeprom_max_write_us)
         {
-            hal_i2c_master_delay(HAL_I2C_MASTER_DELAY_CYCLES);
+            g_hal_i2c_master_eeprom_max_write_us = elapsed_us;
         }
-        attempts++;
+        return true;
     }
 
-    return ready;
+    if (elapsed_us >= (job->device->write_cycle_us * HAL_I2C_M_EEPROM_TIMEOUT_FACTOR))
+    {
+        job->status = HAL_I2C_M_EEPROM_FAILED;
+        return false;
+    }
+
+    job->next_poll_us = elapsed_us + job->poll_gap_us;
+    if (job->poll_gap_us < HAL_I2C_MASTER_POLL_GAP_MAX_US)
+    {
+        job->poll_gap_us <<= 1;
+    }
+
+    return false;
 }
 
-bool HAL_I2C_M_EEPROM_Write(uint16_t memory_address, const uint8_t *data, uint16_t length)
+static bool hal_i2c_master_eeprom_wait_ready(hal_i2c_master_eeprom_job_t *job)
 {
-    if ((data == NULL) || (length == 0U))
+    hal_i2c_master_eeprom_begin_wait(job);
+
+    while (!hal_i2c_master_eeprom_poll_ready(job))
+    {
+        if (job->status == HAL_I2C_M_EEPROM_FAILED)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool hal_i2c_master_eeprom_write_page(hal_i2c_master_eeprom_job_t *job)
+{
+    const hal_i2c_m_eeprom_t *device = job->device;
+    const uint16_t page_size = (device->page_size < HAL_I2C_M_EEPROM_MAX_PAGE_SIZE)
+                                   ? device->page_size
+                                   : (uint16_t)HAL_I2C_M_EEPROM_MAX_PAGE_SIZE;
+    const uint32_t current_address = job->memory_address + job->offset;
+    const uint16_t page_offset = (uint16_t)(current_address % page_size);
+    uint32_t chunk = (uint32_t)page_size - page_offset;
+    uint8_t *payload = g_hal_i2c_master_eeprom_payload;
+
+    if (chunk > (job->length - job->offset))
+    {
+        chunk = job->length - job->offset;
+    }
+
+    const uint8_t address7 = hal_i2c_master_eeprom_header(device, current_address, payload);
+    uint8_t *page = &payload[device->address_bytes];
+
+    if (job->data != NULL)
+    {
+        (void)memcpy(page, &job->data[job->offset], (size_t)chunk);
+    }
+    else if (!job->producer(page, (uint16_t)chunk, job->producer_context))
+    {
+        return false;
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    const hal_i2c_m_speed_t previous = hal_i2c_master_eeprom_select(device);
+    const bool success = HAL_I2C_M_Write(address7, payload, (uint16_t)(chunk + device->address_bytes));
+
+    hal_i2c_master_eeprom_restore(previous);
+
+    if (success)
+    {
+        job->offset += chunk;
+    }
+
+    return success;
+}
+
+/* Pages and the ACK polls between them share one bus hand-over */
+static bool hal_i2c_master_eeprom_run(hal_i2c_master_eeprom_job_t *job)
+{
+    if (!HAL_I2C_M_BeginSession())
     {
         return false;
     }
 
-    uint16_t remaining = length;
-    uint16_t offset = 0U;
     bool success = true;
-    uint8_t payload[HAL_I2C_M_EEPROM_PAGE_SIZE + 2U];
 
-    while ((remaining > 0U) && success)
+    while ((job->offset < job->length) && success)
+    {
+        success = hal_i2c_master_eeprom_write_page(job) && hal_i2c_master_eeprom_wait_ready(job);
+    }
+
+    HAL_I2C_M_EndSession();
+
+    return success;
+}
+
+bool HAL_I2C_M_EEPROM_Write(const hal_i2c_m_eeprom_t *device,
+                            uint32_t memory_address,
+                            const uint8_t *data,
+                            uint16_t length)
+{
+    if ((data == NULL) || !hal_i2c_master_eeprom_valid(device, memory_address, length))
+    {
+        return false;
+    }
+
+    hal_i2c_master_eeprom_job_t job;
+
+    hal_i2c_master_eeprom_job_init(&job, device, memory_address, length);
+    job.data = data;
+
+    return hal_i2c_master_eeprom_run(&job);
+}
+
+bool HAL_I2C_M_EEPROM_WriteAsync(const hal_i2c_m_eeprom_t *device,
+                                 uint32_t memory_address,
+                                 const uint8_t *data,
+                                 uint16_t length,
+                                 hal_i2c_m_callback_t callback,
+                                 void *context)
+{
+    hal_i2c_master_eeprom_job_t *job = &g_hal_i2c_master_eeprom_job;
+
+    if ((data == NULL) || (callback == NULL) || (job->status == HAL_I2C_M_EEPROM_BUSY) ||
+        !hal_i2c_master_eeprom_valid(device, memory_address, length))
+    {
+        return false;
+    }
+
+    hal_i2c_master_eeprom_job_init(job, device, memory_address, length);
+    job->data             = data;
+    job->callback         = callback;
+    job->callback_context = context;
+
+    return true;
+}
+
+bool HAL_I2C_M_EEPROM_IsBusy(void)
+{
+    return (g_hal_i2c_master_eeprom_job.status == HAL_I2C_M_EEPROM_BUSY);
+}
+
+uint32_t HAL_I2C_M_EEPROM_GetLastWriteTimeUs(void)
+{
+    return g_hal_i2c_master_eeprom_last_write_us;
+}
+
+uint32_t HAL_I2C_M_EEPROM_GetMaxWriteTimeUs(void)
+{
+    return g_hal_i2c_master_eeprom_max_write_us;
+}
+
+bool HAL_I2C_M_EEPROM_WaitReady(const hal_i2c_m_eeprom_t *device)
+{
+    if (device == NULL)
+    {
+        return false;
+    }
+
+    const uint32_t start_us = HAL_SCHED_GetUptimeUs();
+    const uint32_t timeout_us = device->write_cycle_us * HAL_I2C_M_EEPROM_TIMEOUT_FACTOR;
+    const hal_i2c_m_speed_t previous = hal_i2c_master_eeprom_select(device);
+    uint32_t next_poll_us = 0UL;
+    uint32_t poll_gap_us = HAL_I2C_MASTER_POLL_GAP_MIN_US;
+    bool ready = false;
+
+    /* The write may be anywhere in its cycle: poll at once, then back off */
+    while (!ready)
     {
-        const uint16_t current_address = (uint16_t)(memory_address + offset);
-        const uint16_t page_offset = (uint16_t)(current_address % HAL_I2C_M_EEPROM_PAGE_SIZE);
-        uint16_t chunk = (uint16_t)(HAL_I2C_M_EEPROM_PAGE_SIZE - page_offset);
+        const uint32_t elapsed_us = HAL_SCHED_GetUptimeUs() - start_us;
 
-        if (chunk > remaining)
+        if (elapsed_us >= timeout_us)
         {
-            chunk = remaining;
+            break;
         }
 
-        payload[0] = (uint8_t)(current_address >> 8);
-        payload[1] = (uint8_t)(current_address & 0xFFU);
-        (void)memcpy(&payload[2], &data[offset], chunk);
+        if (elapsed_us >= next_poll_us)
+        {
+            ready = HAL_I2C_M_Probe(device->address7);
+            next_poll_us = elapsed_us + poll_gap_us;
+            if (poll_gap_us < HAL_I2C_MASTER_POLL_GAP_MAX_US)
+            {
+                poll_gap_us <<= 1;
+            }
+        }
+    }
+
+    hal_i2c_master_eeprom_restore(previous);
 
-        success = HAL_I2C_M_Write(HAL_I2C_M_EEPROM_DEVICE_ADDRESS7, payload, (uint16_t)(chunk + 2U));
-        if (!success)
+    return ready;
+}
+
+/* Settle the job before the callback so it may submit the next write. */
+static void hal_i2c_master_eeprom_finish(hal_i2c_master_eeprom_job_t *job, bool success)
+{
+    const hal_i2c_m_callback_t callback = job->callback;
+
+    job->status = success ? HAL_I2C_M_EEPROM_DONE : HAL_I2C_M_EEPROM_FAILED;
+    if (callback != NULL)
+    {
+        callback(success, job->callback_context);
+    }
+}
+
+hal_sched_pt_status_t HAL_I2C_M_EEPROM_Task(hal_sched_pt_t *pt)
+{
+    hal_i2c_master_eeprom_job_t *job = &g_hal_i2c_master_eeprom_job;
+
+    HAL_SCHED_PT_BEGIN(pt);
+
+    HAL_SCHED_PT_WAIT_UNTIL(pt, job->status == HAL_I2C_M_EEPROM_BUSY);
+
+    while (job->offset < job->length)
+    {
+        if (!hal_i2c_master_eeprom_write_page(job))
         {
-            break;
+            hal_i2c_master_eeprom_finish(job, false);
+            HAL_SCHED_PT_EXIT(pt);
         }
 
-        success = hal_i2c_master_eeprom_wait_ready();
-        if (!success)
+        /* At most one ACK poll per tick so the slave side is serviced in between */
+        hal_i2c_master_eeprom_begin_wait(job);
+        while (!hal_i2c_master_eeprom_poll_ready(job))
         {
-            break;
+            if (job->status == HAL_I2C_M_EEPROM_FAILED)
+            {
+                hal_i2c_master_eeprom_finish(job, false);
+                HAL_SCHED_PT_EXIT(pt);
+            }
+
+            HAL_SCHED_PT_YIELD(pt);
         }
+    }
+
+    hal_i2c_master_eeprom_finish(job, true);
+
+    HAL_SCHED_PT_END(pt);
+}
 
-        offset += chunk;
-        remaining = (uint16_t)(remaining - chunk);
+bool HAL_I2C_M_EEPROM_Read(const hal_i2c_m_eeprom_t *device,
+                           uint32_t memory_address,
+                           uint8_t *data,
+                           uint16_t length)
+{
+    if ((data == NULL) || !hal_i2c_master_eeprom_valid(device, memory_address, length))
+    {
+        return false;
     }
 
+    const uint32_t block_size = hal_i2c_master_eeprom_block_size(device);
+    const hal_i2c_m_speed_t previous = hal_i2c_master_eeprom_select(device);
+    uint16_t done = 0U;
+    const bool in_session = HAL_I2C_M_BeginSession();
+    bool success = in_session;
+
+    /* One sequential read per address block; the internal counter does not cross them */
+    while (success && (done < length))
+    {
+        const uint32_t current_address = memory_address + done;
+        uint8_t header[2];
+        const uint8_t address7 = hal_i2c_master_eeprom_header(device, current_address, header);
+        uint32_t chunk = block_size - (current_address % block_size);
+
+        if (chunk > (uint32_t)(length - done))
+        {
+            chunk = (uint32_t)(length - done);
+        }
+
+        success = HAL_I2C_M_WriteRead(address7, header, device->address_bytes, &data[done], (uint16_t)chunk);
+        done = (uint16_t)(done + chunk);
+    }
+
+    if (in_session)
+    {
+        HAL_I2C_M_EndSession();
+    }
+    hal_i2c_master_eeprom_restore(previous);
+
     return success;
 }
 
-bool HAL_I2C_M_EEPROM_Read(uint16_t memory_address, uint8_t *data, uint16_t length)
+bool HAL_I2C_M_EEPROM_ReadStream(const hal_i2c_m_eeprom_t *device,
+                                 uint32_t memory_address,
+                                 uint32_t length,
+                                 uint8_t *chunk,
+                                 uint16_t chunk_size,
+                                 hal_i2c_m_chunk_fn_t consumer,
+                                 void *context)
 {
-    if ((data == NULL) || (length == 0U))
+    if (!hal_i2c_master_eeprom_valid(device, memory_address, length))
+    {
+        return false;
+    }
+
+    const uint32_t block_size = hal_i2c_master_eeprom_block_size(device);
+    const hal_i2c_m_speed_t previous = hal_i2c_master_eeprom_select(device);
+    uint32_t done = 0UL;
+    const bool in_session = HAL_I2C_M_BeginSession();
+    bool success = in_session;
+
+    while (success && (done < length))
+    {
+        const uint32_t current_address = memory_address + done;
+        uint8_t header[2];
+        const uint8_t address7 = hal_i2c_master_eeprom_header(device, current_address, header);
+        uint32_t span = block_size - (current_address % block_size);
+
+        if (span > (length - done))
+        {
+            span = length - done;
+        }
+
+        success = HAL_I2C_M_WriteReadStream(address7, header, device->address_bytes, span,
+                                            chunk, chunk_size, consumer, context);
+        done += span;
+    }
+
+    if (in_session)
+    {
+        HAL_I2C_M_EndSession();
+    }
+    hal_i2c_master_eeprom_restore(previous);
+
+    return success;
+}
+
+bool HAL_I2C_M_EEPROM_WriteStream(const hal_i2c_m_eeprom_t *device,
+                                  uint32_t memory_address,
+                                  uint32_t length,
+                                  hal_i2c_m_fill_fn_t producer,
+                                  void *context)
+{
+    if ((producer == NULL) || !hal_i2c_master_eeprom_valid(device, memory_address, length))
     {
         return false;
     }
 
-    uint8_t address_bytes[2];
+    hal_i2c_master_eeprom_job_t job;
 
-    address_bytes[0] = (uint8_t)(memory_address >> 8);
-    address_bytes[1] = (uint8_t)(memory_address & 0xFFU);
+    hal_i2c_master_eeprom_job_init(&job, device, memory_address, length);
+    job.producer         = producer;
+    job.producer_context = context;
 
-    return HAL_I2C_M_WriteRead(HAL_I2C_M_EEPROM_DEVICE_ADDRESS7,
-                                    address_bytes,
-                                    (uint16_t)2U,
-                                    data,
-                                    length);
+    return hal_i2c_master_eeprom_run(&job);
 }
@@ -0,0 +1,566 @@
+#include "hal_i2c_master.h"
+
+#if HAL_I2C_M_BACKEND == HAL_I2C_M_BACKEND_IICA1
+
+#include "hal_scheduler.h"
+
+#include "r_cg_macrodriver.h"
+
+#include <stddef.h>
+
+#define HAL_I2C_MASTER_IICCTL0_IICE   (uint8_t)(1U << 7)
+#define HAL_I2C_MASTER_IICCTL0_WREL   (uint8_t)(1U << 5)
+#define HAL_I2C_MASTER_IICCTL0_WTIM   (uint8_t)(1U << 3)
+#define HAL_I2C_MASTER_IICCTL0_ACKE   (uint8_t)(1U << 2)
+#define HAL_I2C_MASTER_IICCTL0_STT    (uint8_t)(1U << 1)
+#define HAL_I2C_MASTER_IICCTL0_SPT    (uint8_t)(1U << 0)
+
+#define HAL_I2C_MASTER_IICS_ALD       (uint8_t)(1U << 6)
+#define HAL_I2C_MASTER_IICS_ACKD      (uint8_t)(1U << 2)
+#define HAL_I2C_MASTER_IICS_STD       (uint8_t)(1U << 1)
+
+#define HAL_I2C_MASTER_IICF_IICBSY    (uint8_t)(1U << 6)
+#define HAL_I2C_MASTER_IICF_STCEN     (uint8_t)(1U << 1)
+#define HAL_I2C_MASTER_IICF_IICRSV    (uint8_t)(1U << 0)
+
+#define HAL_I2C_MASTER_IICCTL1_SMC    (uint8_t)(1U << 3)
+#define HAL_I2C_MASTER_IICCTL1_DFC    (uint8_t)(1U << 2)
+
+#define HAL_I2C_MASTER_NS_TO_FCLK(ns) \
+    ((((ns) * (HAL_I2C_M_CPU_HZ / 1000UL)) + 999999UL) / 1000000UL)
+
+/* IICWL = tLOW, IICWH = period - tLOW - (tR + tF), per UM10204 minimums */
+#define HAL_I2C_MASTER_IICWL(low_ns) \
+    HAL_I2C_MASTER_NS_TO_FCLK(low_ns)
+#define HAL_I2C_MASTER_IICWH(period_ns, low_ns, edges_ns) \
+    (HAL_I2C_MASTER_NS_TO_FCLK(period_ns) - HAL_I2C_MASTER_NS_TO_FCLK(low_ns) - HAL_I2C_MASTER_NS_TO_FCLK(edges_ns))
+
+#if (HAL_I2C_MASTER_IICWL(4700UL) > 255UL) || (HAL_I2C_MASTER_IICWH(10000UL, 4700UL, 1300UL) > 255UL)
+#error "HAL_I2C_M_CPU_HZ too high for IICWL1/IICWH1 in standard mode"
+#endif
+
+typedef struct
+{
+    uint8_t iicwl;
+    uint8_t iicwh;
+    uint8_t iicctl1;
+} hal_i2c_master_iica_timing_t;
+
+static const hal_i2c_master_iica_timing_t g_hal_i2c_master_iica_timings[HAL_I2C_M_SPEED_COUNT] = {
+    { (uint8_t)HAL_I2C_MASTER_IICWL(4700UL), (uint8_t)HAL_I2C_MASTER_IICWH(10000UL, 4700UL, 1300UL), 0U },
+    { (uint8_t)HAL_I2C_MASTER_IICWL(1300UL), (uint8_t)HAL_I2C_MASTER_IICWH(2500UL, 1300UL, 600UL),
+      (uint8_t)(HAL_I2C_MASTER_IICCTL1_SMC | HAL_I2C_MASTER_IICCTL1_DFC) },
+    { (uint8_t)HAL_I2C_MASTER_IICWL(500UL), (uint8_t)HAL_I2C_MASTER_IICWH(1000UL, 500UL, 240UL),
+      HAL_I2C_MASTER_IICCTL1_SMC }
+};
+
+/* Bound for the few-microsecond waits on start-condition generation */
+#define HAL_I2C_MASTER_IICA_SPIN_LIMIT (1000U)
+#define HAL_I2C_MASTER_IICA_TIMEOUT_MS (25U)
+
+/* Lets the host model advance the peripheral while a blocking call waits */
+#ifndef HAL_I2C_MASTER_WAIT_IDLE
+#define HAL_I2C_MASTER_WAIT_IDLE()    R_Config_NOP()
+#endif
+
+typedef enum
+{
+    HAL_I2C_MASTER_IICA_IDLE = 0,
+    HAL_I2C_MASTER_IICA_ADDRESS_WRITE,
+    HAL_I2C_MASTER_IICA_TRANSMIT,
+    HAL_I2C_MASTER_IICA_ADDRESS_READ,
+    HAL_I2C_MASTER_IICA_RECEIVE
+} hal_i2c_master_iica_state_t;
+
+typedef struct
+{
+    const uint8_t                         *tx_data;
+    uint8_t                               *rx_data;
+    uint16_t                               tx_length;
+    uint16_t                               rx_length;
+    uint16_t                               index;
+    uint8_t                                address7;
+    volatile hal_i2c_master_iica_state_t   state;
+    hal_i2c_m_callback_t                   callback;
+    void                                  *context;
+    volatile uint32_t                      rx_left;     /* bytes still to receive */
+    volatile bool                          chunk_full;  /* rx_data full, bus held */
+    volatile uint8_t                       progress;    /* bumped by every byte interrupt */
+} hal_i2c_master_iica_t;
+
+typedef struct
+{
+    volatile bool done;
+    volatile bool success;
+} hal_i2c_master_iica_wait_t;
+
+static hal_i2c_master_iica_t g_hal_i2c_master_iica = { NULL, NULL, 0U, 0U, 0U, 0U, HAL_I2C_MASTER_IICA_IDLE, NULL, NULL, 0UL, false, 0U };
+static hal_i2c_m_speed_t g_hal_i2c_master_iica_speed = HAL_I2C_M_DEFAULT_SPEED;
+
+static uint8_t hal_i2c_master_iica_normalize_address(uint8_t address)
+{
+    if ((address & UINT8_C(0x80)) != 0U)
+    {
+        address >>= 1;
+    }
+
+    return (uint8_t)(address & UINT8_C(0x7F));
+}
+
+static bool hal_i2c_master_iica_start(uint8_t address_byte, bool restart)
+{
+    uint16_t spins = 0U;
+
+    /* A restart is issued while this master still owns the bus */
+    while (!restart && ((IICF1 & HAL_I2C_MASTER_IICF_IICBSY) != 0U))
+    {
+        if (++spins >= HAL_I2C_MASTER_IICA_SPIN_LIMIT)
+        {
+            return false;
+        }
+    }
+
+    IICCTL10 |= HAL_I2C_MASTER_IICCTL0_STT;
+
+    spins = 0U;
+    while ((IICS1 & HAL_I2C_MASTER_IICS_STD) == 0U)
+    {
+        if (++spins >= HAL_I2C_MASTER_IICA_SPIN_LIMIT)
+        {
+            return false;
+        }
+    }
+
+    IICA1 = address_byte;
+
+    return true;
+}
+
+static void hal_i2c_master_iica_finish(bool success, bool send_stop)
+{
+    hal_i2c_master_iica_t *xfer = &g_hal_i2c_master_iica;
+    const hal_i2c_m_callback_t callback = xfer->callback;
+    void *context = xfer->context;
+
+    IICCTL10 &= (uint8_t)(~HAL_I2C_MASTER_IICCTL0_ACKE);
+    if (send_stop)
+    {
+        IICCTL10 |= HAL_I2C_MASTER_IICCTL0_SPT;
+    }
+
+    xfer->callback = NULL;
+    xfer->context  = NULL;
+    xfer->state    = HAL_I2C_MASTER_IICA_IDLE;
+
+    if (callback != NULL)
+    {
+        callback(success, context);
+    }
+}
+
+static void hal_i2c_master_iica_receive_next(const hal_i2c_master_iica_t *xfer)
+{
+    /* ACK every byte but the last so the slave releases SDA for the stop */
+    if (xfer->rx_left > 1U)
+    {
+        IICCTL10 |= HAL_I2C_MASTER_IICCTL0_ACKE;
+    }
+    else
+    {
+        IICCTL10 &= (uint8_t)(~HAL_I2C_MASTER_IICCTL0_ACKE);
+    }
+
+    IICCTL10 |= HAL_I2C_MASTER_IICCTL0_WREL;
+}
+
+static bool hal_i2c_master_iica_submit(uint8_t address,
+                                       const uint8_t *tx_data,
+                                       uint16_t tx_length,
+                                       uint8_t *rx_data,
+                                       uint16_t rx_length,
+                                       uint32_t rx_total,
+                                       hal_i2c_m_callback_t callback,
+                                       void *context)
+{
+    hal_i2c_master_iica_t *xfer = &g_hal_i2c_master_iica;
+
+    if (xfer->state != HAL_I2C_MASTER_IICA_IDLE)
+    {
+        return false;
+    }
+
+    xfer->tx_data   = tx_data;
+    xfer->rx_data   = rx_data;
+    xfer->tx_length = tx_length;
+    xfer->rx_length = rx_length;
+    xfer->rx_left   = rx_total;
+    xfer->index     = 0U;
+    xfer->chunk_full = false;
+    xfer->address7  = hal_i2c_master_iica_normalize_address(address);
+    xfer->callback  = callback;
+    xfer->context   = context;
+
+    const bool read_first = (tx_length == 0U) && (rx_total > 0U);
+    const uint8_t address_byte = (uint8_t)((xfer->address7 << 1) | (read_first ? 1U : 0U));
+
+    xfer->state = read_first ? HAL_I2C_MASTER_IICA_ADDRESS_READ : HAL_I2C_MASTER_IICA_ADDRESS_WRITE;
+
+    if (!hal_i2c_master_iica_start(address_byte, false))
+    {
+        xfer->callback = NULL;
+        xfer->context  = NULL;
+        xfer->state    = HAL_I2C_MASTER_IICA_IDLE;
+        return false;
+    }
+
+    return true;
+}
+
+static void hal_i2c_master_iica_blocking_done(bool success, void *context)
+{
+    hal_i2c_master_iica_wait_t *wait = (hal_i2c_master_iica_wait_t *)context;
+
+    wait->success = success;
+    wait->done    = true;
+}
+
+/*
+ * Blocking waits time out on a stalled bus, not on a long transfer: the
+ * limit restarts whenever the interrupt handler has completed another byte.
+ */
+static bool hal_i2c_master_iica_stalled(uint8_t *last_progress, uint32_t *progress_ms)
+{
+    const uint8_t progress = g_hal_i2c_master_iica.progress;
+    bool stalled = false;
+
+    if (progress != *last_progress)
+    {
+        *last_progress = progress;
+        *progress_ms   = HAL_SCHED_GetUptimeMs();
+    }
+    else if ((HAL_SCHED_GetUptimeMs() - *progress_ms) > HAL_I2C_MASTER_IICA_TIMEOUT_MS)
+    {
+        stalled = true;
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    return stalled;
+}
+
+static void hal_i2c_master_iica_abandon(const hal_i2c_master_iica_wait_t *wait)
+{
+    IICAMK1 = 1U;
+    if (!wait->done)
+    {
+        /* Slave holding the bus or interrupt lost: abandon the transfer */
+        hal_i2c_master_iica_finish(false, true);
+    }
+    IICAMK1 = 0U;
+}
+
+static bool hal_i2c_master_iica_run_blocking(uint8_t address,
+                                             const uint8_t *tx_data,
+                                             uint16_t tx_length,
+                                             uint8_t *rx_data,
+                                             uint16_t rx_length)
+{
+    hal_i2c_master_iica_wait_t wait = { false, false };
+
+    if (!hal_i2c_master_iica_submit(address, tx_data, tx_length, rx_data, rx_length, rx_length,
+                                    hal_i2c_master_iica_blocking_done, &wait))
+    {
+        return false;
+    }
+
+    uint8_t last_progress = g_hal_i2c_master_iica.progress;
+    uint32_t progress_ms = HAL_SCHED_GetUptimeMs();
+
+    while (!wait.done)
+    {
+        if (hal_i2c_master_iica_stalled(&last_progress, &progress_ms))
+        {
+            hal_i2c_master_iica_abandon(&wait);
+            break;
+        }
+
+        HAL_I2C_MASTER_WAIT_IDLE();
+    }
+
+    return wait.success;
+}
+
+static void hal_i2c_master_iica_configure(hal_i2c_m_speed_t speed)
+{
+    const hal_i2c_master_iica_timing_t *timing = &g_hal_i2c_master_iica_timings[speed];
+
+    /* Width and mode registers may only be written with the channel disabled */
+    IICCTL10 = 0U;
+    IICAMK1  = 1U;
+    IICAIF1  = 0U;
+
+    IICWL1   = timing->iicwl;
+    IICWH1   = timing->iicwh;
+    IICCTL11 = timing->iicctl1;
+    SVA1     = 0U;
+    IICF1    = (uint8_t)(HAL_I2C_MASTER_IICF_STCEN | HAL_I2C_MASTER_IICF_IICRSV);
+
+    /* Interrupt after the ninth clock so ACK is visible in the handler */
+    IICCTL10 = (uint8_t)(HAL_I2C_MASTER_IICCTL0_IICE | HAL_I2C_MASTER_IICCTL0_WTIM);
+    IICCTL10 |= HAL_I2C_MASTER_IICCTL0_SPT;
+
+    g_hal_i2c_master_iica_speed = speed;
+
+    IICAMK1 = 0U;
+}
+
+void HAL_I2C_M_Init(void)
+{
+#if defined(IICA1EN)
+    IICA1EN = 1U;
+#endif
+    g_hal_i2c_master_iica.state    = HAL_I2C_MASTER_IICA_IDLE;
+    g_hal_i2c_master_iica.callback = NULL;
+    g_hal_i2c_master_iica.context  = NULL;
+
+    hal_i2c_master_iica_configure(HAL_I2C_M_DEFAULT_SPEED);
+}
+
+bool HAL_I2C_M_BeginSession(void)
+{
+    /* IICA1 has its own pins; nothing to hand over */
+    return true;
+}
+
+void HAL_I2C_M_EndSession(void)
+{
+}
+
+bool HAL_I2C_M_SetBusSpeed(hal_i2c_m_speed_t speed)
+{
+    if ((speed >= HAL_I2C_M_SPEED_COUNT) || (g_hal_i2c_master_iica.state != HAL_I2C_MASTER_IICA_IDLE))
+    {
+        return false;
+    }
+
+    if (speed != g_hal_i2c_master_iica_speed)
+    {
+        hal_i2c_master_iica_configure(speed);
+    }
+
+    return true;
+}
+
+hal_i2c_m_speed_t HAL_I2C_M_GetBusSpeed(void)
+{
+    return g_hal_i2c_master_iica_speed;
+}
+
+bool HAL_I2C_M_WriteRead(uint8_t address,
+                         const uint8_t *tx_data,
+                         uint16_t tx_length,
+                         uint8_t *rx_data,
+                         uint16_t rx_length)
+{
+    if ((tx_length == 0U) && (rx_length == 0U))
+    {
+        return false;
+    }
+
+    if ((tx_length > 0U) && (tx_data == NULL))
+    {
+        return false;
+    }
+
+    if ((rx_length > 0U) && (rx_data == NULL))
+    {
+        return false;
+    }
+
+    return hal_i2c_master_iica_run_blocking(address, tx_data, tx_length, rx_data, rx_length);
+}
+
+bool HAL_I2C_M_Probe(uint8_t address)
+{
+    return hal_i2c_master_iica_run_blocking(address, NULL, 0U, NULL, 0U);
+}
+
+bool HAL_I2C_M_WriteReadStream(uint8_t address,
+                               const uint8_t *tx_data,
+                               uint16_t tx_length,
+                               uint32_t rx_length,
+                               uint8_t *chunk,
+                               uint16_t chunk_size,
+                               hal_i2c_m_chunk_fn_t consumer,
+                               void *context)
+{
+    hal_i2c_master_iica_t *xfer = &g_hal_i2c_master_iica;
+    hal_i2c_master_iica_wait_t wait = { false, false };
+    bool accepted = true;
+
+    if ((rx_length == 0U) || (chunk == NULL) || (chunk_size == 0U) || (consumer == NULL))
+    {
+        return false;
+    }
+
+    if ((tx_length > 0U) && (tx_data == NULL))
+    {
+        return false;
+    }
+
+    if (!hal_i2c_master_iica_submit(address, tx_data, tx_length, chunk, chunk_size, rx_length,
+                                    hal_i2c_master_iica_blocking_done, &wait))
+    {
+        return false;
+    }
+
+    uint8_t last_progress = xfer->progress;
+    uint32_t progress_ms = HAL_SCHED_GetUptimeMs();
+
+    while (!wait.done)
+    {
+        if (xfer->chunk_full)
+        {
+            const bool keep = consumer(chunk, xfer->index, context);
+
+            if (!keep)
+            {
+                /* Receive one more byte with NACK, then stop */
+                accepted = false;
+                xfer->rx_left = 1U;
+            }
+            xfer->index      = 0U;
+            xfer->chunk_full = false;
+            hal_i2c_master_iica_receive_next(xfer);
+        }
+
+        if (hal_i2c_master_iica_stalled(&last_progress, &progress_ms))
+        {
+            hal_i2c_master_iica_abandon(&wait);
+            break;
+        }
+
+        HAL_I2C_MASTER_WAIT_IDLE();
+    }
+
+    if (wait.success && accepted && (xfer->index > 0U))
+    {
+        accepted = consumer(chunk, xfer->index, context);
+    }
+
+    return wait.success && accepted;
+}
+
+bool HAL_I2C_M_WriteReadAsync(uint8_t address,
+                              const uint8_t *tx_data,
+                              uint16_t tx_length,
+                              uint8_t *rx_data,
+                              uint16_t rx_length,
+                              hal_i2c_m_callback_t callback,
+                              void *context)
+{
+    if ((tx_length == 0U) && (rx_length == 0U))
+    {
+        return false;
+    }
+
+    if ((tx_length > 0U) && (tx_data == NULL))
+    {
+        return false;
+    }
+
+    if ((rx_length > 0U) && (rx_data == NULL))
+    {
+        return false;
+    }
+
+    return hal_i2c_master_iica_submit(address, tx_data, tx_length, rx_data, rx_length, rx_length,
+                                      callback, context);
+}
+
+bool HAL_I2C_M_IsBusy(void)
+{
+    return (g_hal_i2c_master_iica.state != HAL_I2C_MASTER_IICA_IDLE);
+}
+
+void HAL_I2C_M_OnInterrupt(void)
+{
+    hal_i2c_master_iica_t *xfer = &g_hal_i2c_master_iica;
+    const uint8_t status = IICS1;
+
+    if ((status & HAL_I2C_MASTER_IICS_ALD) != 0U)
+    {
+        /* Another master owns the bus now; no stop condition from here */
+        hal_i2c_master_iica_finish(false, false);
+        return;
+    }
+
+    xfer->progress++;
+
+    switch (xfer->state)
+    {
+        case HAL_I2C_MASTER_IICA_ADDRESS_WRITE:
+        case HAL_I2C_MASTER_IICA_TRANSMIT:
+            if ((status & HAL_I2C_MASTER_IICS_ACKD) == 0U)
+            {
+                hal_i2c_master_iica_finish(false, true);
+            }
+            else if (xfer->index < xfer->tx_length)
+            {
+                xfer->state = HAL_I2C_MASTER_IICA_TRANSMIT;
+                IICA1 = xfer->tx_data[xfer->index];
+                xfer->index++;
+            }
+            else if (xfer->rx_left > 0U)
+            {
+                xfer->index = 0U;
+                xfer->state = HAL_I2C_MASTER_IICA_ADDRESS_READ;
+                if (!hal_i2c_master_iica_start((uint8_t)((xfer->address7 << 1) | 1U), true))
+                {
+                    hal_i2c_master_iica_finish(false, true);
+                }
+            }
+            else
+            {
+                hal_i2c_master_iica_finish(true, true);
+            }
+            break;
+        case HAL_I2C_MASTER_IICA_ADDRESS_READ:
+            if ((status & HAL_I2C_MASTER_IICS_ACKD) == 0U)
+            {
+                hal_i2c_master_iica_finish(false, true);
+            }
+            else
+            {
+                xfer->state = HAL_I2C_MASTER_IICA_RECEIVE;
+                hal_i2c_master_iica_receive_next(xfer);
+            }
+            break;
+        case HAL_I2C_MASTER_IICA_RECEIVE:
+            xfer->rx_data[xfer->index] = IICA1;
+            xfer->index++;
+            xfer->rx_left--;
+            if (xfer->rx_left == 0U)
+            {
+                hal_i2c_master_iica_finish(true, true);
+            }
+            else if (xfer->index >= xfer->rx_length)
+            {
+                /* Stream buffer full: leave WREL clear so SCL stays low until drained */
+                xfer->chunk_full = true;
+            }
+            else
+            {
+                hal_i2c_master_iica_receive_next(xfer);
+            }
+            break;
+        case HAL_I2C_MASTER_IICA_IDLE:
+        default:
+            /* Stray interrupt, e.g. after an abandoned transfer */
+            break;
+    }
+}
+
+#endif /* HAL_I2C_M_BACKEND == HAL_I2C_M_BACKEND_IICA1 */
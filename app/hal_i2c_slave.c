@@ -1,4 +1,5 @@
 #include "hal_i2c_slave.h"
+#include "hal_critical.h"
 #include "hal_scheduler.h"
 #include "r_config_iica0.h"
 
@@ -52,7 +53,9 @@ typedef struct
 
     hal_i2c_message_t current;
     bool              receiving;
+    bool              discarding;     /* rest of an overrun frame, up to its STOP */
     uint16_t          in_frame_ticks;
+    uint8_t           timeouts;       /* in-frame timeouts since the last good frame */
 
     struct
     {
@@ -63,6 +66,10 @@ typedef struct
     } response;
 
     hal_i2c_error_callback_t error_cb;
+
+    volatile uint8_t         event_id;
+    hal_i2c_recovery_t       event_recovery;
+    hal_i2c_recovery_stats_t recovery_stats;
 } hal_i2c_context_t;
 
 static hal_i2c_context_t g_i2c_ctx = {0};
@@ -71,7 +78,10 @@ static void hal_i2c_rearm_hardware(void);
 static void hal_i2c_reset_current_message(void);
 static void hal_i2c_clear_response(void);
 static hal_i2c_error_t hal_i2c_map_error(uint8_t hw_flags);
+static hal_i2c_recovery_t hal_i2c_recovery_for(hal_i2c_error_t code);
+static void hal_i2c_recover(hal_i2c_recovery_t level);
 static void hal_i2c_report_error(hal_i2c_error_t code, uint8_t hw_flags, bool dropped);
+static void hal_i2c_raise_error(hal_i2c_error_t code, uint8_t hw_flags, bool dropped, hal_i2c_recovery_t level);
 
 static void hal_i2c_rearm_hardware(void)
 {
@@ -84,6 +94,7 @@ static void hal_i2c_rearm_hardware(void)
 static void hal_i2c_reset_current_message(void)
 {
     g_i2c_ctx.receiving      = false;
+    g_i2c_ctx.discarding     = false;
     g_i2c_ctx.in_frame_ticks = 0U;
     g_i2c_ctx.current.length = 0U;
     g_i2c_ctx.current.hw_status_flags = 0U;
@@ -134,6 +145,76 @@ static hal_i2c_error_t hal_i2c_map_error(uint8_t hw_flags)
     return status;
 }
 
+static hal_i2c_recovery_t hal_i2c_recovery_for(hal_i2c_error_t code)
+{
+    hal_i2c_recovery_t level;
+
+    switch (code)
+    {
+        case HAL_I2C_ERR_LINE_STUCK:
+            level = HAL_I2C_RECOVERY_FULL;
+            break;
+        case HAL_I2C_ERR_BUS_ERROR:
+        case HAL_I2C_ERR_ARBITRATION_LOST:
+        case HAL_I2C_ERR_OVERRUN:
+        case HAL_I2C_ERR_TIMEOUT:
+        case HAL_I2C_ERR_NONE:
+            /* Peripheral state is suspect but its configuration is not */
+            level = HAL_I2C_RECOVERY_MEDIUM;
+            break;
+        case HAL_I2C_ERR_NACK:
+        case HAL_I2C_ERR_FRAME:
+        default:
+            level = HAL_I2C_RECOVERY_LIGHT;
+            break;
+    }
+
+    return level;
+}
+
+static void hal_i2c_recover(hal_i2c_recovery_t level)
+{
+    switch (level)
+    {
+        case HAL_I2C_RECOVERY_FULL:
+            hal_i2c_rearm_hardware();
+            hal_i2c_clear_response();
+            hal_i2c_reset_current_message();
+            g_i2c_ctx.recovery_stats.full++;
+            break;
+        case HAL_I2C_RECOVERY_MEDIUM:
+            R_Config_IICA0_SlaveReceiveStart();
+            hal_i2c_clear_response();
+            hal_i2c_reset_current_message();
+            g_i2c_ctx.recovery_stats.medium++;
+            break;
+        case HAL_I2C_RECOVERY_LIGHT:
+            hal_i2c_reset_current_message();
+            g_i2c_ctx.recovery_stats.light++;
+            break;
+        case HAL_I2C_RECOVERY_NONE:
+        default:
+            break;
+    }
+}
+
+/* One error event: recover at its level, then tell the application. */
+static void hal_i2c_raise_error(hal_i2c_error_t code, uint8_t hw_flags, bool dropped, hal_i2c_recovery_t level)
+{
+    g_i2c_ctx.event_id       = (uint8_t)(g_i2c_ctx.event_id + 1U);
+    g_i2c_ctx.event_recovery = level;
+    hal_i2c_recover(level);
+
+    if (code != HAL_I2C_ERR_NONE)
+    {
+        hal_i2c_report_error(code, hw_flags, dropped);
+    }
+    else
+    {
+        /* No action required */
+    }
+}
+
 static void hal_i2c_report_error(hal_i2c_error_t code, uint8_t hw_flags, bool dropped)
 {
     if (g_i2c_ctx.error_cb != NULL)
@@ -144,6 +225,8 @@ static void hal_i2c_report_error(hal_i2c_error_t code, uint8_t hw_flags, bool dr
         context.hw_status_flags = hw_flags;
         context.message_dropped = dropped;
         context.timestamp_ms    = HAL_SCHED_GetUptimeMs();
+        context.event_id        = g_i2c_ctx.event_id;
+        context.recovery        = g_i2c_ctx.event_recovery;
 
         g_i2c_ctx.error_cb(&context);
     }
@@ -159,6 +242,10 @@ void HAL_I2C_S_Init(hal_i2c_error_callback_t error_cb)
     g_i2c_ctx.tail           = 0U;
     g_i2c_ctx.count          = 0U;
     g_i2c_ctx.error_cb       = error_cb;
+    g_i2c_ctx.event_id       = 0U;
+    g_i2c_ctx.event_recovery = HAL_I2C_RECOVERY_NONE;
+    g_i2c_ctx.timeouts       = 0U;
+    (void)memset(&g_i2c_ctx.recovery_stats, 0, sizeof g_i2c_ctx.recovery_stats);
 
     hal_i2c_clear_response();
     hal_i2c_reset_current_message();
@@ -167,9 +254,46 @@ void HAL_I2C_S_Init(hal_i2c_error_callback_t error_cb)
 
 void HAL_I2C_S_Reset(void)
 {
-    hal_i2c_rearm_hardware();
-    hal_i2c_clear_response();
-    hal_i2c_reset_current_message();
+    hal_i2c_recover(HAL_I2C_RECOVERY_FULL);
+}
+
+void HAL_I2C_S_Recover(hal_i2c_recovery_t level)
+{
+    hal_i2c_recover(level);
+}
+
+bool HAL_I2C_S_RecoverEvent(uint8_t event_id, hal_i2c_recovery_t level)
+{
+    hal_critical_state_t state;
+    bool covered;
+
+    /* Masked through the recovery too, so a frame starting meanwhile is not torn down */
+    HAL_CRITICAL_ENTER(state);
+    covered = (event_id != g_i2c_ctx.event_id) || (level <= g_i2c_ctx.event_recovery);
+    if (!covered)
+    {
+        g_i2c_ctx.event_recovery = level;
+        hal_i2c_recover(level);
+    }
+    else
+    {
+        g_i2c_ctx.recovery_stats.coalesced++;
+    }
+    HAL_CRITICAL_EXIT(state);
+
+    return !covered;
+}
+
+void HAL_I2C_S_GetRecoveryStats(hal_i2c_recovery_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = g_i2c_ctx.recovery_stats;
+    }
+    else
+    {
+        /* No action required */
+    }
 }
 
 bool HAL_I2C_S_PopMessage(hal_i2c_message_t *message)
@@ -252,6 +376,7 @@ void HAL_I2C_S_ClearResponse(void)
 void HAL_I2C_S_OnStartCondition(uint8_t hw_status_flags)
 {
     g_i2c_ctx.receiving                = true;
+    g_i2c_ctx.discarding               = false;
     g_i2c_ctx.current.length           = 0U;
     g_i2c_ctx.current.hw_status_flags  = hw_status_flags;
     g_i2c_ctx.in_frame_ticks           = 0U;
@@ -270,8 +395,10 @@ void HAL_I2C_S_OnByteReceived(uint8_t data)
         }
         else
         {
-            hal_i2c_report_error(HAL_I2C_ERR_OVERRUN, g_i2c_ctx.current.hw_status_flags, true);
-            HAL_I2C_S_Reset();
+            /* The rest of the frame is ignored until the next START */
+            hal_i2c_raise_error(HAL_I2C_ERR_OVERRUN, g_i2c_ctx.current.hw_status_flags, true,
+                                HAL_I2C_RECOVERY_LIGHT);
+            g_i2c_ctx.discarding = true;
         }
     }
     else
@@ -293,17 +420,23 @@ void HAL_I2C_S_OnStopCondition(uint8_t hw_status_flags)
             g_i2c_ctx.queue[g_i2c_ctx.head] = g_i2c_ctx.current;
             g_i2c_ctx.head = (uint8_t)((g_i2c_ctx.head + 1U) % HAL_I2C_RING_CAPACITY);
             g_i2c_ctx.count++;
+            g_i2c_ctx.timeouts = 0U;
         }
         else
         {
-            hal_i2c_report_error(HAL_I2C_ERR_OVERRUN, hw_status_flags, true);
+            hal_i2c_raise_error(HAL_I2C_ERR_OVERRUN, hw_status_flags, true, HAL_I2C_RECOVERY_LIGHT);
         }
 
         hal_i2c_reset_current_message();
     }
+    else if (g_i2c_ctx.discarding != false)
+    {
+        /* Expected end of a frame already reported as overrun */
+        g_i2c_ctx.discarding = false;
+    }
     else
     {
-        hal_i2c_report_error(HAL_I2C_ERR_FRAME, hw_status_flags, false);
+        hal_i2c_raise_error(HAL_I2C_ERR_FRAME, hw_status_flags, false, HAL_I2C_RECOVERY_LIGHT);
     }
 }
 
@@ -311,16 +444,7 @@ void HAL_I2C_S_OnHardwareError(uint8_t hw_status_flags)
 {
     const hal_i2c_error_t mapped = hal_i2c_map_error(hw_status_flags);
 
-    if (mapped != HAL_I2C_ERR_NONE)
-    {
-        hal_i2c_report_error(mapped, hw_status_flags, g_i2c_ctx.receiving);
-    }
-    else
-    {
-        /* No action required */
-    }
-
-    HAL_I2C_S_Reset();
+    hal_i2c_raise_error(mapped, hw_status_flags, g_i2c_ctx.receiving, hal_i2c_recovery_for(mapped));
 }
 
 void HAL_I2C_S_Tick1ms(void)
@@ -338,8 +462,15 @@ void HAL_I2C_S_Tick1ms(void)
 
         if (g_i2c_ctx.in_frame_ticks >= HAL_I2C_SLAVE_TIMEOUT_MS)
         {
-            hal_i2c_report_error(HAL_I2C_ERR_TIMEOUT, g_i2c_ctx.current.hw_status_flags, true);
-            HAL_I2C_S_Reset();
+            /* A stalled frame may have wedged reception; re-create if re-arming did not help */
+            const hal_i2c_recovery_t level = (g_i2c_ctx.timeouts == 0U) ? HAL_I2C_RECOVERY_MEDIUM
+                                                                         : HAL_I2C_RECOVERY_FULL;
+
+            if (g_i2c_ctx.timeouts < UINT8_MAX)
+            {
+                g_i2c_ctx.timeouts++;
+            }
+            hal_i2c_raise_error(HAL_I2C_ERR_TIMEOUT, g_i2c_ctx.current.hw_status_flags, true, level);
         }
         else
         {
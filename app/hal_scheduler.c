@@ -1,15 +1,131 @@
 #include "hal_scheduler.h"
+#include "hal_critical.h"
+#include "hal_probe.h"
+#include "r_cg_macrodriver.h"
 
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+/*
+ * Tick timer access for sub-tick timestamps. The default maps to TAU0
+ * channel 0 (TM00), which counts down from TDR00 and raises TMIF00 on reload.
+ */
+#ifndef HAL_SCHED_TIMER_COUNTER
+#if defined(TCR00) && defined(TDR00)
+#define HAL_SCHED_TIMER_COUNTER()  ((uint16_t)TCR00)
+#define HAL_SCHED_TIMER_RELOAD()   ((uint16_t)TDR00)
+#else
+#define HAL_SCHED_TIMER_COUNTER()  ((uint16_t)0U)
+#define HAL_SCHED_TIMER_RELOAD()   ((uint16_t)0U)
+#endif
+#endif
+
+#ifndef HAL_SCHED_TIMER_PENDING
+#if defined(TMIF00)
+#define HAL_SCHED_TIMER_PENDING()  (TMIF00 != 0U)
+#else
+#define HAL_SCHED_TIMER_PENDING()  (false)
+#endif
+#endif
+
+/* A single slot cannot tell published (pos + 1) from free (pos + depth) */
+#if (HAL_SCHED_WORK_QUEUE_DEPTH < 2U) || (HAL_SCHED_WORK_QUEUE_DEPTH > 64U) || \
+    ((HAL_SCHED_WORK_QUEUE_DEPTH & (HAL_SCHED_WORK_QUEUE_DEPTH - 1U)) != 0U)
+#error "HAL_SCHED_WORK_QUEUE_DEPTH must be a power of two between 2 and 64"
+#endif
+
+#if (HAL_SCHED_PHASE_WINDOW_TICKS == 0U) || (HAL_SCHED_PHASE_WINDOW_TICKS > 255U)
+#error "HAL_SCHED_PHASE_WINDOW_TICKS must be between 1 and 255"
+#endif
+
+#define HAL_SCHED_WORK_QUEUE_MASK  ((uint8_t)(HAL_SCHED_WORK_QUEUE_DEPTH - 1U))
+
+/*
+ * Bounded multi-producer/single-consumer ring. Each slot carries a sequence
+ * number: producers claim a position with a CAS on enqueue_pos and publish
+ * the slot by advancing its sequence; the scheduler is the only consumer.
+ * The payload is volatile too so its stores cannot move past the publish.
+ */
+typedef struct
+{
+    hal_sched_work_fn_t volatile function;
+    volatile uint16_t            argument;
+    volatile uint8_t             sequence;
+} hal_sched_work_slot_t;
+
+typedef struct
+{
+    hal_sched_work_slot_t slots[HAL_SCHED_WORK_QUEUE_DEPTH];
+    volatile uint8_t      enqueue_pos;
+    uint8_t               dequeue_pos;
+    volatile uint16_t     dropped;
+} hal_sched_work_queue_t;
+
+#define HAL_SCHED_STARVATION_MAGIC  UINT32_C(0x53544156)
+
 static hal_sched_task_t *g_task_table = NULL;
 static uint8_t            g_task_count = 0U;
 static volatile uint32_t  g_uptime_ticks = 0UL;
 static uint16_t           g_tick_hz = 0U;
+#if HAL_SCHED_TICK_HZ == 0U
+static uint32_t           g_tick_us = 0UL;
+static volatile uint32_t  g_uptime_ms = 0UL;
+static uint32_t           g_ms_accumulator = 0UL;
+#define HAL_SCHED_TICK_US()  (g_tick_us)
+#else
+#define HAL_SCHED_TICK_US()  (UINT32_C(1000000) / (uint32_t)HAL_SCHED_TICK_HZ)
+#endif
+static hal_sched_work_queue_t g_work_queue;
+static uint8_t            g_current_task = UINT8_MAX;
+
+/*
+ * Not cleared by startup code so the record survives a watchdog reset. The
+ * linker setup has to keep it that way: on CC-RL, leave HAL_NOINIT_n out of
+ * the section table cstart.asm zero-fills; with GCC, map .noinit as NOLOAD
+ * outside .bss. Power-on garbage fails the magic/check test and reads as no
+ * record.
+ */
+#if defined(__CCRL__)
+#pragma section bss HAL_NOINIT
+static hal_sched_starvation_record_t g_starvation_record;
+#pragma section
+#elif defined(__GNUC__)
+static hal_sched_starvation_record_t g_starvation_record __attribute__((section(".noinit")));
+#else
+static hal_sched_starvation_record_t g_starvation_record;
+#endif
 
+static uint32_t hal_sched_read_u32(const volatile uint32_t *counter);
 static bool hal_sched_is_time_due(uint32_t current, uint32_t deadline);
+static void hal_sched_add_saturating(uint16_t *counter, uint32_t amount);
+static void hal_sched_advance_deadline(hal_sched_task_t *task, uint32_t now);
+static void hal_sched_run_task(hal_sched_task_t *task, uint32_t now);
+static void hal_sched_work_queue_reset(void);
+static uint8_t hal_sched_phase_span(const hal_sched_task_t *task);
+static uint8_t hal_sched_record_check(const hal_sched_starvation_record_t *record);
+static void hal_sched_phase_mark(uint8_t *load, uint16_t period, uint8_t phase);
+static uint8_t hal_sched_phase_pick(const uint8_t *load, uint16_t period);
+static void hal_sched_drain_work(void);
+
+/*
+ * A 32-bit load is two 16-bit accesses on RL78; re-read until two samples
+ * agree so a tick ISR between the halves cannot produce a torn value.
+ */
+static uint32_t hal_sched_read_u32(const volatile uint32_t *counter)
+{
+    uint32_t first;
+    uint32_t second;
+
+    do
+    {
+        first  = *counter;
+        second = *counter;
+    }
+    while (first != second);
+
+    return first;
+}
 
 static bool hal_sched_is_time_due(uint32_t current, uint32_t deadline)
 {
@@ -28,12 +144,258 @@ static bool hal_sched_is_time_due(uint32_t current, uint32_t deadline)
     return is_due;
 }
 
-void HAL_SCHED_Init(uint16_t tick_hz)
+static void hal_sched_add_saturating(uint16_t *counter, uint32_t amount)
+{
+    const uint32_t sum = (uint32_t)*counter + amount;
+
+    *counter = (sum > (uint32_t)UINT16_MAX) ? UINT16_MAX : (uint16_t)sum;
+}
+
+static void hal_sched_advance_deadline(hal_sched_task_t *task, uint32_t now)
+{
+    if (task->period_ticks == 0U)
+    {
+        task->next_deadline = now + UINT32_C(1);
+    }
+    else
+    {
+        const uint32_t period   = (uint32_t)task->period_ticks;
+        const uint32_t lateness = now - task->next_deadline;
+        uint32_t missed = 0UL;
+
+        if (lateness > (uint32_t)task->max_lateness_ticks)
+        {
+            task->max_lateness_ticks = (lateness > (uint32_t)UINT16_MAX) ? UINT16_MAX : (uint16_t)lateness;
+        }
+        else
+        {
+            /* No action required */
+        }
+
+        if (lateness >= period)
+        {
+            missed = lateness / period;
+        }
+        else
+        {
+            /* No action required */
+        }
+
+        switch (task->overrun_policy)
+        {
+            case HAL_SCHED_OVERRUN_CATCH_UP:
+                if (missed > (uint32_t)HAL_SCHED_CATCH_UP_MAX_PERIODS)
+                {
+                    const uint32_t dropped = missed - (uint32_t)HAL_SCHED_CATCH_UP_MAX_PERIODS;
+
+                    task->next_deadline += dropped * period;
+                    hal_sched_add_saturating(&task->skipped_periods, dropped);
+                }
+                else
+                {
+                    /* No action required */
+                }
+                task->next_deadline += period;
+                break;
+            case HAL_SCHED_OVERRUN_SKIP_TO_NOW:
+                task->next_deadline = now + period;
+                hal_sched_add_saturating(&task->skipped_periods, missed);
+                break;
+            case HAL_SCHED_OVERRUN_FIXED_RATE:
+            default:
+                task->next_deadline += (missed + UINT32_C(1)) * period;
+                hal_sched_add_saturating(&task->skipped_periods, missed);
+                break;
+        }
+    }
+}
+
+static void hal_sched_run_task(hal_sched_task_t *task, uint32_t now)
+{
+    HAL_PROBE_ENTER(TASK);
+
+    if (task->function != NULL)
+    {
+        task->function();
+        hal_sched_advance_deadline(task, now);
+    }
+    else if (task->coroutine != NULL)
+    {
+        const hal_sched_pt_status_t status = task->coroutine(&task->pt);
+
+        if (status == HAL_SCHED_PT_YIELDED)
+        {
+            task->next_deadline = now + UINT32_C(1);
+        }
+        else
+        {
+            hal_sched_advance_deadline(task, now);
+        }
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    HAL_PROBE_EXIT(TASK);
+}
+
+static uint8_t hal_sched_record_check(const hal_sched_starvation_record_t *record)
+{
+    const uint32_t folded = record->magic ^ record->uptime_ms ^ record->silent_ticks;
+
+    return (uint8_t)~((uint8_t)(folded ^ (folded >> 8) ^ (folded >> 16) ^ (folded >> 24)) ^ record->task_index);
+}
+
+static uint8_t hal_sched_phase_span(const hal_sched_task_t *task)
+{
+    uint16_t span = task->period_ticks;
+
+    if ((span == 0U) || (span > HAL_SCHED_PHASE_WINDOW_TICKS))
+    {
+        span = (task->period_ticks == 0U) ? 1U : (uint16_t)HAL_SCHED_PHASE_WINDOW_TICKS;
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    return (uint8_t)span;
+}
+
+static void hal_sched_phase_mark(uint8_t *load, uint16_t period, uint8_t phase)
 {
+    const uint16_t step = (period == 0U) ? 1U : period;
+    uint16_t slot;
+
+    for (slot = phase; slot < HAL_SCHED_PHASE_WINDOW_TICKS; slot = (uint16_t)(slot + step))
+    {
+        if (load[slot] < UINT8_MAX)
+        {
+            load[slot]++;
+        }
+        else
+        {
+            /* No action required */
+        }
+    }
+}
+
+/* Pick the phase whose firing slots have the lowest peak, then total, load. */
+static uint8_t hal_sched_phase_pick(const uint8_t *load, uint16_t period)
+{
+    const uint16_t step = (period == 0U) ? 1U : period;
+    const uint8_t candidates = (step > HAL_SCHED_PHASE_WINDOW_TICKS) ? (uint8_t)HAL_SCHED_PHASE_WINDOW_TICKS : (uint8_t)step;
+    uint8_t  best_phase = 0U;
+    uint8_t  best_peak  = UINT8_MAX;
+    uint16_t best_total = UINT16_MAX;
+    uint8_t  phase;
+
+    for (phase = 0U; phase < candidates; phase++)
+    {
+        uint8_t  peak  = 0U;
+        uint16_t total = 0U;
+        uint16_t slot;
+
+        for (slot = phase; slot < HAL_SCHED_PHASE_WINDOW_TICKS; slot = (uint16_t)(slot + step))
+        {
+            if (load[slot] > peak)
+            {
+                peak = load[slot];
+            }
+            total = (uint16_t)(total + load[slot]);
+        }
+
+        if ((peak < best_peak) || ((peak == best_peak) && (total < best_total)))
+        {
+            best_phase = phase;
+            best_peak  = peak;
+            best_total = total;
+        }
+        else
+        {
+            /* No action required */
+        }
+    }
+
+    return best_phase;
+}
+
+static void hal_sched_work_queue_reset(void)
+{
+    uint8_t index;
+
+    for (index = 0U; index < (uint8_t)HAL_SCHED_WORK_QUEUE_DEPTH; index++)
+    {
+        g_work_queue.slots[index].function = NULL;
+        g_work_queue.slots[index].argument = 0U;
+        g_work_queue.slots[index].sequence = index;
+    }
+
+    g_work_queue.enqueue_pos = 0U;
+    g_work_queue.dequeue_pos = 0U;
+    g_work_queue.dropped     = 0U;
+}
+
+static void hal_sched_drain_work(void)
+{
+    uint8_t budget;
+
+    /* Bounded to one queue's worth so producers cannot starve the tasks */
+    for (budget = 0U; budget < (uint8_t)HAL_SCHED_WORK_QUEUE_DEPTH; budget++)
+    {
+        const uint8_t position = g_work_queue.dequeue_pos;
+        hal_sched_work_slot_t *slot = &g_work_queue.slots[position & HAL_SCHED_WORK_QUEUE_MASK];
+
+        if (slot->sequence != (uint8_t)(position + 1U))
+        {
+            break;
+        }
+
+        const hal_sched_work_fn_t function = slot->function;
+        const uint16_t argument = slot->argument;
+
+        g_work_queue.dequeue_pos = (uint8_t)(position + 1U);
+        slot->sequence = (uint8_t)(position + (uint8_t)HAL_SCHED_WORK_QUEUE_DEPTH);
+
+        if (function != NULL)
+        {
+            function(argument);
+        }
+        else
+        {
+            /* No action required */
+        }
+    }
+}
+
+bool HAL_SCHED_Init(uint16_t tick_hz)
+{
+#if HAL_SCHED_TICK_HZ == 0U
+    if (tick_hz == 0U)
+    {
+        return false;
+    }
+#else
+    /* The uptime counters are built on the compile-time rate */
+    if (tick_hz != (uint16_t)HAL_SCHED_TICK_HZ)
+    {
+        return false;
+    }
+#endif
+
     g_tick_hz      = tick_hz;
     g_uptime_ticks = 0UL;
+#if HAL_SCHED_TICK_HZ == 0U
+    g_tick_us        = (tick_hz > 0U) ? (UINT32_C(1000000) / (uint32_t)tick_hz) : 0UL;
+    g_uptime_ms      = 0UL;
+    g_ms_accumulator = 0UL;
+#endif
     g_task_table   = NULL;
     g_task_count   = 0U;
+    hal_sched_work_queue_reset();
+
+    return true;
 }
 
 void HAL_SCHED_RegisterTasks(hal_sched_task_t *tasks, uint8_t task_count)
@@ -46,15 +408,47 @@ void HAL_SCHED_RegisterTasks(hal_sched_task_t *tasks, uint8_t task_count)
     else
     {
         uint8_t index;
-        const uint32_t now = g_uptime_ticks;
+        uint8_t load[HAL_SCHED_PHASE_WINDOW_TICKS] = {0};
+        const uint32_t now = hal_sched_read_u32(&g_uptime_ticks);
 
         g_task_table = tasks;
         g_task_count = task_count;
 
+        /* Fixed phases claim their slots first so auto tasks steer around them */
+        for (index = 0U; index < g_task_count; index++)
+        {
+            const hal_sched_task_t *task = &g_task_table[index];
+
+            if (task->phase_ticks != HAL_SCHED_PHASE_AUTO)
+            {
+                const uint8_t span = hal_sched_phase_span(task);
+
+                hal_sched_phase_mark(load, task->period_ticks, (uint8_t)(task->phase_ticks % span));
+            }
+            else
+            {
+                /* No action required */
+            }
+        }
+
         for (index = 0U; index < g_task_count; index++)
         {
             hal_sched_task_t *task = &g_task_table[index];
-            task->next_deadline = now + (uint32_t)task->period_ticks;
+            uint16_t phase = task->phase_ticks;
+
+            if (phase == HAL_SCHED_PHASE_AUTO)
+            {
+                phase = hal_sched_phase_pick(load, task->period_ticks);
+                hal_sched_phase_mark(load, task->period_ticks, (uint8_t)phase);
+            }
+            else
+            {
+                /* No action required */
+            }
+
+            task->next_deadline = now + (uint32_t)task->period_ticks + (uint32_t)phase;
+            task->last_checkin  = now;
+            HAL_SCHED_PT_INIT(&task->pt);
         }
     }
 }
@@ -62,12 +456,24 @@ void HAL_SCHED_RegisterTasks(hal_sched_task_t *tasks, uint8_t task_count)
 void HAL_SCHED_TickISR(void)
 {
     g_uptime_ticks++;
+
+#if HAL_SCHED_TICK_HZ == 0U
+    /* Bresenham-style accumulation keeps the ISR free of divisions */
+    g_ms_accumulator += UINT32_C(1000);
+    while ((g_tick_hz > 0U) && (g_ms_accumulator >= (uint32_t)g_tick_hz))
+    {
+        g_ms_accumulator -= (uint32_t)g_tick_hz;
+        g_uptime_ms++;
+    }
+#endif
 }
 
 void HAL_SCHED_RunOnce(void)
 {
     uint8_t index;
-    const uint32_t now = g_uptime_ticks;
+    const uint32_t now = hal_sched_read_u32(&g_uptime_ticks);
+
+    hal_sched_drain_work();
 
     if (g_task_table == NULL)
     {
@@ -78,52 +484,216 @@ void HAL_SCHED_RunOnce(void)
     {
         hal_sched_task_t *task = &g_task_table[index];
 
-        if (task->function != NULL)
+        if (hal_sched_is_time_due(now, task->next_deadline) != false)
         {
-            if (hal_sched_is_time_due(now, task->next_deadline) != false)
-            {
-                task->function();
+            g_current_task = index;
+            hal_sched_run_task(task, now);
+            g_current_task = UINT8_MAX;
+        }
+        else
+        {
+            /* No action required */
+        }
+    }
+}
 
-                if (task->period_ticks == 0U)
-                {
-                    task->next_deadline = now + UINT32_C(1);
-                }
-                else
-                {
-                    do
-                    {
-                        task->next_deadline += (uint32_t)task->period_ticks;
-                    }
-                    while (hal_sched_is_time_due(now, task->next_deadline) != false);
-                }
+uint32_t HAL_SCHED_GetUptimeMs(void)
+{
+#if HAL_SCHED_TICK_HZ == 1000U
+    return hal_sched_read_u32(&g_uptime_ticks);
+#elif HAL_SCHED_TICK_HZ == 0U
+    return hal_sched_read_u32(&g_uptime_ms);
+#else
+    /* Fixed non-1 kHz rate: constant divisor folds to a multiply/shift */
+    const uint32_t ticks_snapshot = hal_sched_read_u32(&g_uptime_ticks);
+
+    return (uint32_t)(((uint64_t)ticks_snapshot * UINT64_C(1000)) / (uint64_t)HAL_SCHED_TICK_HZ);
+#endif
+}
+
+uint32_t HAL_SCHED_GetUptimeUs(void)
+{
+    uint32_t ticks_snapshot;
+    uint16_t counter;
+    bool     pending;
+
+    /* Retry if the tick ISR ran or the reload flag changed while sampling */
+    do
+    {
+        ticks_snapshot = hal_sched_read_u32(&g_uptime_ticks);
+        pending        = HAL_SCHED_TIMER_PENDING();
+        counter        = HAL_SCHED_TIMER_COUNTER();
+    }
+    while ((ticks_snapshot != hal_sched_read_u32(&g_uptime_ticks)) ||
+           (pending != HAL_SCHED_TIMER_PENDING()));
+
+    if (pending)
+    {
+        /* Counter already reloaded but the ISR has not counted the tick yet */
+        ticks_snapshot++;
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    const uint16_t reload  = HAL_SCHED_TIMER_RELOAD();
+    const uint16_t elapsed = (counter <= reload) ? (uint16_t)(reload - counter) : 0U;
+    uint32_t sub_tick_us = 0UL;
+
+    if (reload > 0U)
+    {
+        sub_tick_us = ((uint32_t)elapsed * HAL_SCHED_TICK_US()) / ((uint32_t)reload + 1UL);
+    }
+    else
+    {
+        /* No action required */
+    }
+
+    return (ticks_snapshot * HAL_SCHED_TICK_US()) + sub_tick_us;
+}
+
+uint32_t HAL_SCHED_GetTicks(void)
+{
+    return hal_sched_read_u32(&g_uptime_ticks);
+}
+
+bool HAL_SCHED_IsTickDue(uint32_t tick)
+{
+    return hal_sched_is_time_due(hal_sched_read_u32(&g_uptime_ticks), tick);
+}
+
+void HAL_SCHED_CheckIn(void)
+{
+    if ((g_task_table != NULL) && (g_current_task < g_task_count))
+    {
+        g_task_table[g_current_task].last_checkin = hal_sched_read_u32(&g_uptime_ticks);
+    }
+    else
+    {
+        /* No action required */
+    }
+}
+
+bool HAL_SCHED_SupervisorHealthy(void)
+{
+    uint8_t index;
+    bool healthy = true;
+    const uint32_t now = hal_sched_read_u32(&g_uptime_ticks);
+
+    for (index = 0U; (g_task_table != NULL) && (index < g_task_count); index++)
+    {
+        const hal_sched_task_t *task = &g_task_table[index];
+        const uint32_t silent = now - task->last_checkin;
+
+        if ((task->liveness_ticks != 0U) && (silent > (uint32_t)task->liveness_ticks))
+        {
+            healthy = false;
+
+            if (g_starvation_record.magic != HAL_SCHED_STARVATION_MAGIC)
+            {
+                g_starvation_record.magic        = HAL_SCHED_STARVATION_MAGIC;
+                g_starvation_record.uptime_ms    = HAL_SCHED_GetUptimeMs();
+                g_starvation_record.silent_ticks = silent;
+                g_starvation_record.task_index   = index;
+                g_starvation_record.check        = hal_sched_record_check(&g_starvation_record);
             }
             else
             {
-                /* No action required */
+                /* Keep the first offender */
             }
+            break;
         }
         else
         {
             /* No action required */
         }
     }
+
+    return healthy;
 }
 
-uint32_t HAL_SCHED_GetUptimeMs(void)
+bool HAL_SCHED_GetStarvationRecord(hal_sched_starvation_record_t *record)
 {
-    uint32_t uptime_ms = 0UL;
+    bool valid = false;
 
-    if (g_tick_hz > 0U)
+    if ((record != NULL) &&
+        (g_starvation_record.magic == HAL_SCHED_STARVATION_MAGIC) &&
+        (g_starvation_record.check == hal_sched_record_check(&g_starvation_record)))
     {
-        const uint32_t ticks_snapshot = g_uptime_ticks;
-        const uint64_t scaled = ((uint64_t)ticks_snapshot * UINT64_C(1000));
-
-        uptime_ms = (uint32_t)(scaled / (uint64_t)g_tick_hz);
+        *record = g_starvation_record;
+        valid = true;
     }
     else
     {
         /* No action required */
     }
 
-    return uptime_ms;
+    return valid;
+}
+
+void HAL_SCHED_ClearStarvationRecord(void)
+{
+    g_starvation_record.magic = 0UL;
+    g_starvation_record.check = 0U;
+}
+
+bool HAL_SCHED_Defer(hal_sched_work_fn_t function, uint16_t argument)
+{
+    bool queued = false;
+    uint8_t position = g_work_queue.enqueue_pos;
+
+    if (function == NULL)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        hal_sched_work_slot_t *slot = &g_work_queue.slots[position & HAL_SCHED_WORK_QUEUE_MASK];
+        const int8_t lag = (int8_t)(uint8_t)(slot->sequence - position);
+
+        if (lag == 0)
+        {
+            if (hal_critical_cas_u8(&g_work_queue.enqueue_pos, position, (uint8_t)(position + 1U)))
+            {
+                slot->function = function;
+                slot->argument = argument;
+                slot->sequence = (uint8_t)(position + 1U);
+                queued = true;
+                break;
+            }
+        }
+        else if (lag < 0)
+        {
+            /* Slot still owned by the consumer: queue is full */
+            break;
+        }
+        else
+        {
+            /* No action required */
+        }
+
+        /* A nested producer won the race; retry from its position */
+        position = g_work_queue.enqueue_pos;
+    }
+
+    if (!queued)
+    {
+        hal_critical_state_t state;
+
+        HAL_CRITICAL_ENTER(state);
+        if (g_work_queue.dropped < UINT16_MAX)
+        {
+            g_work_queue.dropped++;
+        }
+        HAL_CRITICAL_EXIT(state);
+    }
+
+    return queued;
+}
+
+uint16_t HAL_SCHED_GetDeferDropCount(void)
+{
+    return g_work_queue.dropped;
 }
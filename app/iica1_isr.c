@@ -0,0 +1,10 @@
+#include "hal_i2c_master.h"
+#include "r_cg_macrodriver.h"
+
+#if HAL_I2C_M_BACKEND == HAL_I2C_M_BACKEND_IICA1
+#pragma interrupt INTIICA1 IICA1_ISR
+void IICA1_ISR(void)
+{
+    HAL_I2C_M_OnInterrupt();
+}
+#endif
@@ -1,99 +1,209 @@
 #include "hal_i2c_slave.h"
+#include "hal_gpio.h"
 #include "r_config_iica0.h"
+#include "hal_probe.h"
 #include "r_cg_macrodriver.h"
 
+#ifndef R_IICA0_LINE_SDA
+#define R_IICA0_LINE_SDA  (1U << 0)
+#endif
+#ifndef R_IICA0_LINE_SCL
+#define R_IICA0_LINE_SCL  (1U << 1)
+#endif
+
+/* SDA0/SCL0 on P60/P61 */
+#define R_IICA0_SDA_MASK    ((uint8_t)(1U << 0))
+#define R_IICA0_SCL_MASK    ((uint8_t)(1U << 1))
+#define R_IICA0_PINS_MASK   ((uint8_t)(R_IICA0_SDA_MASK | R_IICA0_SCL_MASK))
+
+#if defined(P6) && defined(PM6)
+#if defined(PU6)
+#define R_IICA0_PU_REG      (&PU6)
+#else
+#define R_IICA0_PU_REG      (NULL)
+#endif
+#if defined(PMC6)
+#define R_IICA0_PMC_REG     (&PMC6)
+#else
+#define R_IICA0_PMC_REG     (NULL)
+#endif
+
+static const hal_gpio_port_pins_t g_r_iica0_pins = {
+    &P6, &PM6, R_IICA0_PU_REG, R_IICA0_PMC_REG, R_IICA0_PINS_MASK
+};
+#endif
+
+/* Host builds advance a virtual clock in the delay and read modelled lines */
+#ifndef R_IICA0_ELAPSE
+#define R_IICA0_ELAPSE(cycles)  ((void)0)
+#endif
+#ifndef R_IICA0_READ_PORT
+#define R_IICA0_READ_PORT()     (P6)
+#endif
+#define R_IICA0_DELAY_LOOP_CYCLES  (8UL)
+
+/* IICE0 in IICCTL00; CLD0/DAD0 in IICCTL01 report the SCL0/SDA0 pin levels */
+#define R_IICA0_IICE_MASK   ((uint8_t)(1U << 7))
+#define R_IICA0_CLD_MASK    ((uint8_t)(1U << 5))
+#define R_IICA0_DAD_MASK    ((uint8_t)(1U << 4))
+
+/* IICA0RES in the peripheral reset control register */
+#define R_IICA0_RESET_MASK  ((uint8_t)(1U << 4))
+
 static void r_iica0_delay_cycles(uint16_t cycles)
 {
     volatile uint16_t counter = cycles;
 
+    R_IICA0_ELAPSE((uint32_t)cycles * R_IICA0_DELAY_LOOP_CYCLES);
+
     while (counter-- != 0U)
     {
         /* Busy-wait to let the bus settle */
     }
 }
 
+#if defined(P6) && defined(PM6)
+/* Latch low before the pin turns output, so a line is never driven high */
+static void r_iica0_drive_low(uint8_t mask)
+{
+    P6 &= (uint8_t)(~mask);
+    R_IICA0_ELAPSE(0U);
+    PM6 &= (uint8_t)(~mask);
+    R_IICA0_ELAPSE(0U);
+}
+
+static void r_iica0_release(uint8_t mask)
+{
+    PM6 |= mask;
+    R_IICA0_ELAPSE(0U);
+}
+#endif
+
 void R_Config_IICA0_ResetBusLines(void)
 {
     R_Config_IICA0_Stop();
 
 #if defined(P6) && defined(PM6)
-    const uint8_t scl_mask  = (uint8_t)(1U << 1);
-    const uint8_t sda_mask  = (uint8_t)(1U << 0);
-    const uint8_t pins_mask = (uint8_t)(scl_mask | sda_mask);
-    const uint8_t p6_backup  = P6;
-    const uint8_t pm6_backup = PM6;
-#if defined(PMC6)
-    const uint8_t pmc6_backup = PMC6;
-#endif
-#if defined(PU6)
-    const uint8_t pu6_backup = PU6;
-#endif
+    const uint8_t scl_mask  = R_IICA0_SCL_MASK;
+    const uint8_t sda_mask  = R_IICA0_SDA_MASK;
+    hal_gpio_port_snapshot_t snapshot;
 
-#if defined(PMC6)
-    PMC6 &= (uint8_t)(~pins_mask);
-#endif
-#if defined(PU6)
-    PU6 |= pins_mask;
-#endif
-
-    PM6 |= pins_mask;
+    HAL_GPIO_ClaimPins(&g_r_iica0_pins, &snapshot);
+    R_IICA0_ELAPSE(0U);
 
     for (uint8_t pulse = 0U; pulse < 9U; ++pulse)
     {
-        PM6 &= (uint8_t)(~scl_mask);
-        P6 &= (uint8_t)(~scl_mask);
+        r_iica0_drive_low(scl_mask);
         r_iica0_delay_cycles(UINT16_C(200));
 
-        PM6 |= scl_mask;
+        r_iica0_release(scl_mask);
         r_iica0_delay_cycles(UINT16_C(200));
 
-        if ((P6 & sda_mask) != 0U)
+        if ((R_IICA0_READ_PORT() & sda_mask) != 0U)
         {
             break;
         }
     }
 
-    PM6 &= (uint8_t)(~sda_mask);
-    P6 &= (uint8_t)(~sda_mask);
+    r_iica0_drive_low(sda_mask);
     r_iica0_delay_cycles(UINT16_C(200));
 
-    PM6 &= (uint8_t)(~scl_mask);
-    P6 &= (uint8_t)(~scl_mask);
+    r_iica0_drive_low(scl_mask);
     r_iica0_delay_cycles(UINT16_C(200));
 
-    PM6 |= scl_mask;
+    r_iica0_release(scl_mask);
     r_iica0_delay_cycles(UINT16_C(200));
 
-    PM6 |= sda_mask;
+    r_iica0_release(sda_mask);
     r_iica0_delay_cycles(UINT16_C(200));
 
-#if defined(PU6)
-    PU6 = (uint8_t)((PU6 & (uint8_t)(~pins_mask)) | (pu6_backup & pins_mask));
-#endif
-    P6  = (uint8_t)((P6 & (uint8_t)(~pins_mask)) | (p6_backup & pins_mask));
-    PM6 = (uint8_t)((PM6 & (uint8_t)(~pins_mask)) | (pm6_backup & pins_mask));
-#if defined(PMC6)
-    PMC6 = (uint8_t)((PMC6 & (uint8_t)(~pins_mask)) | (pmc6_backup & pins_mask));
-#endif
+    HAL_GPIO_RestorePins(&g_r_iica0_pins, &snapshot);
 #endif /* defined(P6) && defined(PM6) */
 }
 
+uint8_t R_Config_IICA0_SampleBusLines(void)
+{
+    uint8_t lines = (uint8_t)(R_IICA0_LINE_SDA | R_IICA0_LINE_SCL);
+
+#if defined(IICCTL00) && defined(IICCTL01)
+    /*
+     * While IICA0 runs it drives the pins: releasing them through PM6 would
+     * glitch an ACK in flight and hide SCL held low by IICA0 itself.
+     */
+    if ((IICCTL00 & R_IICA0_IICE_MASK) != 0U)
+    {
+        const uint8_t detect = IICCTL01;
+
+        lines = 0U;
+        if ((detect & R_IICA0_DAD_MASK) != 0U)
+        {
+            lines |= (uint8_t)R_IICA0_LINE_SDA;
+        }
+        if ((detect & R_IICA0_CLD_MASK) != 0U)
+        {
+            lines |= (uint8_t)R_IICA0_LINE_SCL;
+        }
+        return lines;
+    }
+#endif /* defined(IICCTL00) && defined(IICCTL01) */
+
+#if defined(P6) && defined(PM6)
+    const uint8_t pm6_backup = PM6;
+
+    /* Peripheral stopped: in output mode P6 reads back the latch; switch to input to see the pins */
+    PM6 |= R_IICA0_PINS_MASK;
+    const uint8_t levels = R_IICA0_READ_PORT();
+    PM6 = (uint8_t)((PM6 & (uint8_t)(~R_IICA0_PINS_MASK)) | (pm6_backup & R_IICA0_PINS_MASK));
+
+    lines = 0U;
+    if ((levels & R_IICA0_SDA_MASK) != 0U)
+    {
+        lines |= (uint8_t)R_IICA0_LINE_SDA;
+    }
+    if ((levels & R_IICA0_SCL_MASK) != 0U)
+    {
+        lines |= (uint8_t)R_IICA0_LINE_SCL;
+    }
+#endif /* defined(P6) && defined(PM6) */
+
+    return lines;
+}
+
+void R_Config_IICA0_ResetPeripheral(void)
+{
+    R_Config_IICA0_Stop();
+
+#if defined(PRR0)
+    /* Returns every IICA0 register to its reset value; Create reprograms them */
+    PRR0 |= R_IICA0_RESET_MASK;
+    PRR0 &= (uint8_t)(~R_IICA0_RESET_MASK);
+#endif
+}
+
 void R_Config_IICA0_SlaveStartCallback(uint8_t status_flags)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnStartCondition(status_flags);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
 
 void R_Config_IICA0_SlaveReceiveCallback(uint8_t data_byte)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnByteReceived(data_byte);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
 
 void R_Config_IICA0_SlaveStopCallback(uint8_t status_flags)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnStopCondition(status_flags);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
 
 void R_Config_IICA0_ErrorCallback(uint8_t status_flags)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnHardwareError(status_flags);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
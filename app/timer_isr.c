@@ -1,10 +1,13 @@
 #include "hal_i2c_slave.h"
 #include "hal_scheduler.h"
+#include "hal_probe.h"
 #include "r_cg_macrodriver.h"
 
 #pragma interrupt INTTM00 TM00_ISR
 void TM00_ISR(void)
 {
+    HAL_PROBE_ENTER(TM00_ISR);
     HAL_SCHED_TickISR();
     HAL_I2C_S_Tick1ms();
+    HAL_PROBE_EXIT(TM00_ISR);
 }
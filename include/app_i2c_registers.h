@@ -8,10 +8,14 @@
 
 #define APP_I2C_REG_ADDR_HW_VERSION    (0x01U)
 #define APP_I2C_REG_ADDR_SW_VERSION    (0x02U)
+#define APP_I2C_REG_ADDR_STARVATION    (0x03U)
 
 #define APP_I2C_HW_VERSION_BYTES       { 0x00U, 0x01U }
 #define APP_I2C_SW_VERSION_BYTES       { 0x00U, 0x10U }
 
+/* Valid flag, task index, uptime_ms and silent_ticks (big endian) */
+#define APP_I2C_STARVATION_LENGTH      (10U)
+
 typedef void (*app_i2c_command_handler_t)(const hal_i2c_message_t *message);
 
 typedef struct
@@ -27,4 +31,7 @@ extern const size_t g_app_i2c_command_count;
 
 const app_i2c_command_descriptor_t *APP_I2C_FindCommand(uint8_t reg_address);
 
+/* Publish the task starvation that caused the last watchdog reset; read-only from the bus. */
+void APP_I2C_SetStarvationReport(uint8_t task_index, uint32_t uptime_ms, uint32_t silent_ticks);
+
 #endif /* APP_I2C_REGISTERS_H */
@@ -0,0 +1,103 @@
+#ifndef APP_KV_STORE_H
+#define APP_KV_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hal_i2c_master.h"
+
+/*
+ * Log-structured key/value store on an EEPROM region. The region is split
+ * into two banks of fixed-size records; every Set or Delete appends one
+ * record (a single page program) to the active bank, so updates of a hot key
+ * walk across the bank instead of rewriting one page. When the active bank
+ * is full the live values are compacted into the other bank, which becomes
+ * active once its header record is written; an interrupted compaction leaves
+ * the previous bank in charge. Values are served from a RAM index built at
+ * Init, so Get never touches the bus.
+ *
+ * Two checkpoint copies at the start of the region hold a CRC-protected
+ * snapshot of that index with a generation counter. Init reads the newest
+ * intact copy plus the records appended since it was taken, and falls back
+ * to scanning the active bank only when no copy is usable. Checkpoints taken
+ * after compaction or an interval of appends go through the non-blocking
+ * EEPROM writer (HAL_I2C_M_EEPROM_Task must be registered) so the slave side
+ * keeps being serviced; Init and APP_KV_Checkpoint write synchronously.
+ *
+ * The region must not also be accessed through the EEPROM cache.
+ */
+#ifndef APP_KV_REGION_BASE
+#define APP_KV_REGION_BASE   (0x0000UL)
+#endif
+
+#ifndef APP_KV_REGION_SIZE
+#define APP_KV_REGION_SIZE   (2048UL)
+#endif
+
+/* Must divide the device page size so a record is one page program */
+#ifndef APP_KV_RECORD_SIZE
+#define APP_KV_RECORD_SIZE   (16U)
+#endif
+
+/* Distinct keys held in the RAM index */
+#ifndef APP_KV_MAX_KEYS
+#define APP_KV_MAX_KEYS      (16U)
+#endif
+
+/*
+ * Appends after which the checkpoint is refreshed; bounds the boot replay.
+ * Raised to the bank size at Init so the checkpoint pages wear no faster
+ * than the log.
+ */
+#ifndef APP_KV_CHECKPOINT_INTERVAL
+#define APP_KV_CHECKPOINT_INTERVAL  (32U)
+#endif
+
+/* Record: key, length, 32-bit sequence, value, CRC-16 */
+#define APP_KV_VALUE_MAX     (APP_KV_RECORD_SIZE - 8U)
+
+/* One checkpoint copy: 18-byte header and every index entry, in whole records */
+#define APP_KV_CHECKPOINT_SIZE \
+    ((((18U + (APP_KV_MAX_KEYS * (2U + APP_KV_VALUE_MAX))) + APP_KV_RECORD_SIZE) - 1U) / \
+     APP_KV_RECORD_SIZE * APP_KV_RECORD_SIZE)
+
+/* Reserved for the bank header record */
+#define APP_KV_KEY_INVALID   (0xFFU)
+
+typedef struct
+{
+    uint32_t appends;        /* records written, compaction copies included */
+    uint32_t compactions;
+    uint32_t sequence;       /* next record sequence number */
+    uint8_t  keys;           /* live keys in the index */
+    uint8_t  active_bank;
+    uint16_t free_records;   /* appends left before the next compaction */
+    uint32_t checkpoints;    /* checkpoint copies written */
+    bool     checkpoint_boot; /* Init restored the index from a checkpoint */
+} app_kv_stats_t;
+
+/*
+ * Bind the store to base..base+length of the device and rebuild the index.
+ * A region with no valid bank header is formatted. Returns false on a bad
+ * geometry or a device error. Blocks for the whole scan; the watchdog is
+ * refreshed once per record read.
+ */
+bool APP_KV_Init(const hal_i2c_m_eeprom_t *device, uint32_t base_address, uint32_t length);
+
+/* Copies up to capacity bytes; length receives the stored size. */
+bool APP_KV_Get(uint8_t key, uint8_t *value, uint8_t capacity, uint8_t *length);
+bool APP_KV_Set(uint8_t key, const uint8_t *value, uint8_t length);
+bool APP_KV_Delete(uint8_t key);
+
+/* Move the live values into the other bank now instead of when full. */
+bool APP_KV_Compact(void);
+
+/*
+ * Snapshot the index now, e.g. before a planned power-down. False on a device
+ * error or while a background checkpoint is still being written.
+ */
+bool APP_KV_Checkpoint(void);
+
+void APP_KV_GetStats(app_kv_stats_t *stats);
+
+#endif /* APP_KV_STORE_H */
@@ -0,0 +1,85 @@
+#ifndef HAL_CRITICAL_H
+#define HAL_CRITICAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "r_cg_macrodriver.h"
+
+/*
+ * Short interrupt-masked sections. The previous PSW is restored on exit, so
+ * the macros are safe to use from ISRs without enabling nesting by accident.
+ * Host test builds define HAL_HOST_TEST (tests/mocks/r_cg_macrodriver.h) and
+ * run single-threaded, so masking is a no-op there; any other target without
+ * a branch below is an error rather than a silently unprotected build.
+ */
+typedef uint8_t hal_critical_state_t;
+
+#if defined(HAL_HOST_TEST)
+#define HAL_CRITICAL_ENTER(state)                                              \
+    do                                                                         \
+    {                                                                          \
+        (state) = (hal_critical_state_t)0U;                                    \
+    } while (0)
+#define HAL_CRITICAL_EXIT(state)   ((void)(state))
+#elif defined(__CCRL__)
+#define HAL_CRITICAL_ENTER(state)                                              \
+    do                                                                         \
+    {                                                                          \
+        (state) = (hal_critical_state_t)__get_psw();                           \
+        __DI();                                                                \
+    } while (0)
+#define HAL_CRITICAL_EXIT(state)   __set_psw((unsigned char)(state))
+#elif defined(__GNUC__) && defined(__RL78__)
+/* PSW is the SFR at FFFFAH, reachable with a near access; IE is bit 7 */
+#define HAL_CRITICAL_PSW           (*(volatile uint8_t *)0xFFFAU)
+#define HAL_CRITICAL_PSW_IE        ((hal_critical_state_t)0x80U)
+#define HAL_CRITICAL_ENTER(state)                                              \
+    do                                                                         \
+    {                                                                          \
+        (state) = (hal_critical_state_t)HAL_CRITICAL_PSW;                      \
+        __asm__ volatile ("di" ::: "memory");                                  \
+    } while (0)
+#define HAL_CRITICAL_EXIT(state)                                               \
+    do                                                                         \
+    {                                                                          \
+        if (((state) & HAL_CRITICAL_PSW_IE) != 0U)                             \
+        {                                                                      \
+            __asm__ volatile ("ei" ::: "memory");                              \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            __asm__ volatile ("" ::: "memory");                                \
+        }                                                                      \
+    } while (0)
+#else
+#error "hal_critical.h: no interrupt masking for this compiler and target"
+#endif
+
+/*
+ * Single-byte compare-and-swap. Host test builds use the GCC-style atomic;
+ * RL78 has no CAS, so the compare and store are done with interrupts masked
+ * for a few cycles.
+ */
+static inline bool hal_critical_cas_u8(volatile uint8_t *target, uint8_t expected, uint8_t desired)
+{
+#if defined(HAL_HOST_TEST) && defined(__GNUC__)
+    return __atomic_compare_exchange_n(target, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#else
+    hal_critical_state_t state;
+    bool swapped = false;
+
+    HAL_CRITICAL_ENTER(state);
+    if (*target == expected)
+    {
+        *target = desired;
+        swapped = true;
+    }
+    HAL_CRITICAL_EXIT(state);
+
+    return swapped;
+#endif
+}
+
+#endif /* HAL_CRITICAL_H */
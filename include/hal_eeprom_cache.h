@@ -0,0 +1,59 @@
+#ifndef HAL_EEPROM_CACHE_H
+#define HAL_EEPROM_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hal_i2c_master.h"
+
+/*
+ * Write-back cache in front of one I2C EEPROM. Writes are merged into a line
+ * and its dirty span programmed on HAL_EEPROM_CACHE_Flush, on eviction, or
+ * from HAL_EEPROM_CACHE_IdleTask once no write has arrived for the idle
+ * delay. The line size must divide the part's page size, so every write-back
+ * is a single page program; HAL_EEPROM_CACHE_Init rejects other parts. A miss
+ * during a background flush waits for the device to finish its write cycle.
+ */
+/* 8U for parts with 8-byte pages such as the 24C02 */
+#ifndef HAL_EEPROM_CACHE_LINE_SIZE
+#define HAL_EEPROM_CACHE_LINE_SIZE      (16U)
+#endif
+
+#ifndef HAL_EEPROM_CACHE_LINES
+#define HAL_EEPROM_CACHE_LINES          (4U)
+#endif
+
+#ifndef HAL_EEPROM_CACHE_IDLE_FLUSH_MS
+#define HAL_EEPROM_CACHE_IDLE_FLUSH_MS  (100U)
+#endif
+
+typedef struct
+{
+    uint32_t read_hits;
+    uint32_t read_misses;
+    uint32_t writes;       /* HAL_EEPROM_CACHE_Write calls */
+    uint32_t page_writes;  /* page programs issued to the device */
+} hal_eeprom_cache_stats_t;
+
+bool HAL_EEPROM_CACHE_Init(const hal_i2c_m_eeprom_t *device);
+bool HAL_EEPROM_CACHE_Read(uint32_t memory_address, uint8_t *data, uint16_t length);
+bool HAL_EEPROM_CACHE_Write(uint32_t memory_address, const uint8_t *data, uint16_t length);
+
+/*
+ * Program every dirty line with blocking writes. Returns false on a device
+ * error, or while a background flush from the idle task is still running.
+ */
+bool HAL_EEPROM_CACHE_Flush(void);
+
+/* Drop all lines, dirty ones included. */
+void HAL_EEPROM_CACHE_Invalidate(void);
+
+/*
+ * Scheduler task: hands one dirty line at a time to the non-blocking EEPROM
+ * writer (HAL_I2C_M_EEPROM_Task must be registered as well).
+ */
+void HAL_EEPROM_CACHE_IdleTask(void);
+
+void HAL_EEPROM_CACHE_GetStats(hal_eeprom_cache_stats_t *stats);
+
+#endif /* HAL_EEPROM_CACHE_H */
@@ -32,6 +32,50 @@ typedef struct
     bool inverted;
 } hal_gpio_pin_config_t;
 
+/*
+ * Set of logical pins for the group calls: bit N stands for pin id N, so
+ * group writes and reads cover the first 32 pins of the table. The same
+ * layout carries the levels, a set bit meaning HAL_GPIO_LEVEL_HIGH.
+ */
+typedef uint32_t hal_gpio_group_t;
+
+#define HAL_GPIO_GROUP_PIN(pin)  ((hal_gpio_group_t)1UL << (uint8_t)(pin))
+
+/* Distinct port registers one group call may touch */
+#ifndef HAL_GPIO_GROUP_MAX_PORTS
+#define HAL_GPIO_GROUP_MAX_PORTS  (4U)
+#endif
+
+/*
+ * Pins of one port for a temporary takeover by a driver. Registers the
+ * device lacks are NULL and are never touched; only bits in mask are saved
+ * and restored.
+ */
+typedef struct
+{
+    volatile uint8_t *port_reg;       /* Pn */
+    volatile uint8_t *direction_reg;  /* PMn */
+    volatile uint8_t *pullup_reg;     /* PUn */
+    volatile uint8_t *mode_ctl_reg;   /* PMCn */
+    uint8_t           mask;
+} hal_gpio_port_pins_t;
+
+typedef struct
+{
+    uint8_t port;
+    uint8_t direction;
+    uint8_t pullup;
+    uint8_t mode_ctl;
+} hal_gpio_port_snapshot_t;
+
+/* Saved state of every port touched by a pin group of the table. */
+typedef struct
+{
+    hal_gpio_port_pins_t     ports[HAL_GPIO_GROUP_MAX_PORTS];
+    hal_gpio_port_snapshot_t saved[HAL_GPIO_GROUP_MAX_PORTS];
+    uint8_t                  count;
+} hal_gpio_group_snapshot_t;
+
 void HAL_GPIO_Init(void);
 
 bool HAL_GPIO_IsValid(hal_gpio_pin_id_t pin);
@@ -42,8 +86,47 @@ bool HAL_GPIO_Write(hal_gpio_pin_id_t pin, hal_gpio_level_t level);
 
 bool HAL_GPIO_Read(hal_gpio_pin_id_t pin, hal_gpio_level_t *level);
 
+/*
+ * Drive the logical level HIGH or LOW. Like every write of this module the
+ * port update runs with interrupts masked, so it is safe against an ISR
+ * writing another pin of the same port.
+ */
+bool HAL_GPIO_Set(hal_gpio_pin_id_t pin);
+bool HAL_GPIO_Clear(hal_gpio_pin_id_t pin);
+
+/* Invert the output latch in one access, independent of the input level. */
 bool HAL_GPIO_Toggle(hal_gpio_pin_id_t pin);
 
+/*
+ * Drive every pin in the group to its bit in levels, inversion applied.
+ * Each affected port register is written once, so pins sharing a port
+ * change together. Nothing is written if any pin is invalid or the group
+ * spans more than HAL_GPIO_GROUP_MAX_PORTS ports.
+ */
+bool HAL_GPIO_WriteGroup(hal_gpio_group_t pins, hal_gpio_group_t levels);
+
+/* Sample each input register of the group once; bits outside pins read 0. */
+bool HAL_GPIO_ReadGroup(hal_gpio_group_t pins, hal_gpio_group_t *levels);
+
+void HAL_GPIO_SnapshotPins(const hal_gpio_port_pins_t *pins, hal_gpio_port_snapshot_t *snapshot);
+
+/*
+ * Snapshot, then switch the pins to digital inputs with pull-ups and clear
+ * their latch: released open-drain lines that the caller drives low by
+ * making them outputs, never high.
+ */
+void HAL_GPIO_ClaimPins(const hal_gpio_port_pins_t *pins, hal_gpio_port_snapshot_t *snapshot);
+
+/* Put the masked bits back: pull-up and mode first, then latch, then direction. */
+void HAL_GPIO_RestorePins(const hal_gpio_port_pins_t *pins, const hal_gpio_port_snapshot_t *snapshot);
+
+/*
+ * Table-driven forms: one snapshot per port register of the group, covering
+ * the port, direction and pull-up registers named in the table.
+ */
+bool HAL_GPIO_SnapshotGroup(hal_gpio_group_t pins, hal_gpio_group_snapshot_t *snapshot);
+void HAL_GPIO_RestoreGroup(const hal_gpio_group_snapshot_t *snapshot);
+
 uint8_t HAL_GPIO_PinCount(void);
 
 #endif /* HAL_GPIO_H */
@@ -14,4 +14,9 @@
 #define HAL_GPIO_PIN_TABLE(_ENTRY) /* Populate with board pins */
 #endif
 
+/*
+ * Timing probe pins (see hal_probe.h), output pins of the table above:
+ *   #define HAL_PROBE_PIN_TM00_ISR   HAL_GPIO_PIN_FOO
+ */
+
 #endif /* HAL_GPIO_BOARD_H */
@@ -0,0 +1,67 @@
+#ifndef HAL_GPIO_INPUT_H
+#define HAL_GPIO_INPUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hal_gpio.h"
+
+/*
+ * Debounced inputs for every pin of the table configured as an input. Each
+ * HAL_GPIO_INPUT_Task call reads every input port once and advances a 2-bit
+ * vertical counter per pin with a handful of bitwise operations per port, so
+ * the cost does not grow with the number of pins. A pin changes state after
+ * four consecutive samples at the new level; the change is then posted to
+ * the subscribers of that pin and edge. Levels are logical: inversion from
+ * the table is applied.
+ *
+ * Call HAL_GPIO_INPUT_Init after HAL_GPIO_Init and register the task with
+ * the scheduler; its period sets the debounce time (four periods).
+ */
+#ifndef HAL_GPIO_INPUT_MAX_PORTS
+#define HAL_GPIO_INPUT_MAX_PORTS        (4U)
+#endif
+
+#ifndef HAL_GPIO_INPUT_MAX_SUBSCRIBERS
+#define HAL_GPIO_INPUT_MAX_SUBSCRIBERS  (4U)
+#endif
+
+typedef enum
+{
+    HAL_GPIO_EDGE_RISING  = 1,
+    HAL_GPIO_EDGE_FALLING = 2,
+    HAL_GPIO_EDGE_BOTH    = 3
+} hal_gpio_edge_t;
+
+/* Called from HAL_GPIO_INPUT_Task with a single edge bit set. */
+typedef void (*hal_gpio_input_callback_t)(hal_gpio_pin_id_t pin, hal_gpio_edge_t edge);
+
+typedef struct
+{
+    uint32_t samples;   /* task runs */
+    uint32_t edges;     /* debounced changes */
+    uint8_t  ports;     /* input registers sampled per run */
+} hal_gpio_input_stats_t;
+
+/*
+ * Collect the input pins and seed the debounced state from one sample, so
+ * no edges are reported for the levels found at start-up. Returns false if
+ * the inputs span more than HAL_GPIO_INPUT_MAX_PORTS registers.
+ */
+bool HAL_GPIO_INPUT_Init(void);
+
+/* Scheduler task: one sample of every input port. */
+void HAL_GPIO_INPUT_Task(void);
+
+/*
+ * Deliver the given edges of every pin in the group to callback. Every pin
+ * must be a configured input; subscriptions are cleared by Init.
+ */
+bool HAL_GPIO_INPUT_Subscribe(hal_gpio_group_t pins, hal_gpio_edge_t edges, hal_gpio_input_callback_t callback);
+
+/* Debounced level; false for a pin that is not a configured input. */
+bool HAL_GPIO_INPUT_Read(hal_gpio_pin_id_t pin, hal_gpio_level_t *level);
+
+void HAL_GPIO_INPUT_GetStats(hal_gpio_input_stats_t *stats);
+
+#endif /* HAL_GPIO_INPUT_H */
@@ -2,6 +2,9 @@
 #define HAL_GPIO_PINMAP_H
 
 #include "hal_gpio.h"
+#include "hal_critical.h"
+
+#include <stddef.h>
 
 /*
  * Define HAL_GPIO_PIN_TABLE(ENTRY) before including this header to provide
@@ -30,4 +33,52 @@ enum hal_gpio_pin_id_t
 extern const hal_gpio_pin_config_t g_hal_gpio_pinmap[];
 extern const uint8_t g_hal_gpio_pinmap_count;
 
+/*
+ * Fixed-pin accessors generated from the same table. The register, mask and
+ * polarity are constants, so with a constant level a write reduces to one
+ * bit set or clear on the port latch and a read to one bit test. There is
+ * no validation: use them with table names only, and keep HAL_GPIO_Write and
+ * friends for pins chosen at run time. The registers named in the table must
+ * be visible wherever this header is included. A single set1/clr1 is atomic;
+ * the toggle is a read-modify-write and masks interrupts around it.
+ *
+ *   HAL_GPIO_WRITE_FAST(HAL_GPIO_PIN_STATUS_LED, HAL_GPIO_LEVEL_HIGH);
+ */
+#define HAL_GPIO_WRITE_FAST(pin, level)  hal_gpio_fast_write_##pin(level)
+#define HAL_GPIO_READ_FAST(pin)          hal_gpio_fast_read_##pin()
+#define HAL_GPIO_TOGGLE_FAST(pin)        hal_gpio_fast_toggle_##pin()
+
+static inline const volatile uint8_t *hal_gpio_fast_input(const volatile uint8_t *input_reg,
+                                                          const volatile uint8_t *port_reg)
+{
+    return (input_reg != NULL) ? input_reg : port_reg;
+}
+
+#define HAL_GPIO_DECLARE_FAST(name, port_reg, direction_reg, pullup_reg, input_reg, mask, default_mode, default_level, inverted) \
+    static inline void hal_gpio_fast_write_##name(hal_gpio_level_t level)                      \
+    {                                                                                          \
+        if ((level == HAL_GPIO_LEVEL_HIGH) != (inverted))                                      \
+        {                                                                                      \
+            *(port_reg) |= (uint8_t)(mask);                                                    \
+        }                                                                                      \
+        else                                                                                   \
+        {                                                                                      \
+            *(port_reg) &= (uint8_t)(~(uint8_t)(mask));                                        \
+        }                                                                                      \
+    }                                                                                          \
+    static inline hal_gpio_level_t hal_gpio_fast_read_##name(void)                             \
+    {                                                                                          \
+        const bool is_high = ((*hal_gpio_fast_input((input_reg), (port_reg)) & (uint8_t)(mask)) != 0U); \
+        return (is_high != (inverted)) ? HAL_GPIO_LEVEL_HIGH : HAL_GPIO_LEVEL_LOW;              \
+    }                                                                                          \
+    static inline void hal_gpio_fast_toggle_##name(void)                                       \
+    {                                                                                          \
+        hal_critical_state_t hal_gpio_state;                                                   \
+        HAL_CRITICAL_ENTER(hal_gpio_state);                                                    \
+        *(port_reg) ^= (uint8_t)(mask);                                                        \
+        HAL_CRITICAL_EXIT(hal_gpio_state);                                                     \
+    }
+HAL_GPIO_PIN_TABLE(HAL_GPIO_DECLARE_FAST)
+#undef HAL_GPIO_DECLARE_FAST
+
 #endif /* HAL_GPIO_PINMAP_H */
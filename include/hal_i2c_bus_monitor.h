@@ -0,0 +1,97 @@
+#ifndef HAL_I2C_BUS_MONITOR_H
+#define HAL_I2C_BUS_MONITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hal_i2c_slave.h"
+
+/*
+ * Bus-level fault handling for the IICA0 slave. A reported fault is
+ * classified from the sampled SDA/SCL levels and answered with the lightest
+ * action that can clear it: re-arm the slave, clock the bus free with SCL
+ * pulses, or reset the peripheral. Faults that recur while the backoff from
+ * the previous recovery is running are folded into one recovery at its end,
+ * one level further up, and the backoff doubles. A quiet period starts the
+ * ladder over.
+ */
+#ifndef HAL_I2C_BUS_BACKOFF_MIN_MS
+#define HAL_I2C_BUS_BACKOFF_MIN_MS  (10U)
+#endif
+
+#ifndef HAL_I2C_BUS_BACKOFF_MAX_MS
+#define HAL_I2C_BUS_BACKOFF_MAX_MS  (1280U)
+#endif
+
+/*
+ * A line only counts as stuck when it reads low for this long, ten SCL
+ * periods at 100 kHz, and at least HAL_I2C_BUS_STUCK_SAMPLES times: traffic
+ * and short clock stretching pull the lines low only briefly.
+ */
+#ifndef HAL_I2C_BUS_STUCK_WINDOW_US
+#define HAL_I2C_BUS_STUCK_WINDOW_US (100U)
+#endif
+
+#ifndef HAL_I2C_BUS_STUCK_SAMPLES
+#define HAL_I2C_BUS_STUCK_SAMPLES   (4U)
+#endif
+
+/* Fault-free time after which escalation and backoff start over */
+#ifndef HAL_I2C_BUS_HEALTHY_MS
+#define HAL_I2C_BUS_HEALTHY_MS      (1000U)
+#endif
+
+typedef enum
+{
+    HAL_I2C_BUS_FAULT_NONE = 0,   /* both lines high */
+    HAL_I2C_BUS_FAULT_GLITCH,     /* error reported, lines idle */
+    HAL_I2C_BUS_FAULT_SDA_STUCK,  /* a device holds SDA low mid-byte */
+    HAL_I2C_BUS_FAULT_SCL_STUCK   /* SCL held low */
+} hal_i2c_bus_fault_t;
+
+typedef enum
+{
+    HAL_I2C_BUS_ACTION_NONE = 0,
+    HAL_I2C_BUS_ACTION_REARM,     /* slave MEDIUM recovery, coalesced with the ISR's */
+    HAL_I2C_BUS_ACTION_PULSE,     /* nine SCL pulses and a STOP, then re-arm */
+    HAL_I2C_BUS_ACTION_RESET,     /* peripheral reset, pulses, then re-arm */
+    HAL_I2C_BUS_ACTION_COUNT
+} hal_i2c_bus_action_t;
+
+typedef struct
+{
+    uint32_t             faults;       /* ReportFault calls */
+    uint32_t             deferred;     /* faults folded into a held-back recovery */
+    uint32_t             actions[HAL_I2C_BUS_ACTION_COUNT];
+    uint32_t             last_recovery_us;
+    uint32_t             max_recovery_us;
+    uint16_t             backoff_ms;   /* hold-off after the last recovery */
+    hal_i2c_bus_fault_t  last_fault;
+    hal_i2c_bus_action_t last_action;
+    bool                 lines_idle;   /* SDA and SCL high after the last recovery */
+} hal_i2c_bus_stats_t;
+
+void HAL_I2C_BUS_Init(void);
+
+/*
+ * Sample SDA/SCL over the stuck window and classify; NONE once both lines
+ * have been seen high. Busy-waits up to HAL_I2C_BUS_STUCK_WINDOW_US.
+ */
+hal_i2c_bus_fault_t HAL_I2C_BUS_Classify(void);
+
+/*
+ * Report a bus-level slave error (bus error, stuck line, lost arbitration)
+ * with the event_id from its error context. Task context: recovery may run
+ * from here.
+ */
+void HAL_I2C_BUS_ReportFault(hal_i2c_error_t code, uint8_t event_id);
+
+/*
+ * Scheduler task: runs a recovery held back by the backoff, and retries while
+ * the last one left a line low.
+ */
+void HAL_I2C_BUS_Task(void);
+
+void HAL_I2C_BUS_GetStats(hal_i2c_bus_stats_t *stats);
+
+#endif /* HAL_I2C_BUS_MONITOR_H */
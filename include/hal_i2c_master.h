@@ -4,9 +4,135 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-#define HAL_I2C_M_EEPROM_DEVICE_ADDRESS8  (0xA0U)
-#define HAL_I2C_M_EEPROM_DEVICE_ADDRESS7  (HAL_I2C_M_EEPROM_DEVICE_ADDRESS8 >> 1)
-#define HAL_I2C_M_EEPROM_PAGE_SIZE        (16U)
+#include "hal_scheduler.h"
+
+/*
+ * Transfer backend. GPIO bit-bangs P6 and keeps the CPU busy for the whole
+ * transfer; IICA1 drives the second IICA channel from INTIICA1 so the CPU is
+ * free while bytes are on the wire and IICA0 keeps serving the slave side.
+ */
+#define HAL_I2C_M_BACKEND_GPIO   (0U)
+#define HAL_I2C_M_BACKEND_IICA1  (1U)
+
+#ifndef HAL_I2C_M_BACKEND
+#define HAL_I2C_M_BACKEND  HAL_I2C_M_BACKEND_GPIO
+#endif
+
+/* Core clock the bit timing is derived from (fCLK, also clocks IICA1) */
+#ifndef HAL_I2C_M_CPU_HZ
+#define HAL_I2C_M_CPU_HZ  (32000000UL)
+#endif
+
+typedef enum
+{
+    HAL_I2C_M_SPEED_STANDARD = 0,  /* 100 kHz */
+    HAL_I2C_M_SPEED_FAST,          /* 400 kHz */
+    HAL_I2C_M_SPEED_FAST_PLUS,     /* 1 MHz   */
+    HAL_I2C_M_SPEED_COUNT
+} hal_i2c_m_speed_t;
+
+#ifndef HAL_I2C_M_DEFAULT_SPEED
+#define HAL_I2C_M_DEFAULT_SPEED  HAL_I2C_M_SPEED_STANDARD
+#endif
+
+/*
+ * Longest a slave may hold SCL low (clock stretching) before the bit-banged
+ * transfer is abandoned as failed.
+ */
+#ifndef HAL_I2C_M_STRETCH_TIMEOUT_US
+#define HAL_I2C_M_STRETCH_TIMEOUT_US  (1000UL)
+#endif
+
+/* Transactions that can be pending in the HAL_I2C_M_Submit queue */
+#ifndef HAL_I2C_M_QUEUE_DEPTH
+#define HAL_I2C_M_QUEUE_DEPTH  (4U)
+#endif
+
+/*
+ * Largest page program issued in one transaction. Parts with bigger pages are
+ * written in aligned pieces of this size; it also sizes the shared payload.
+ */
+#ifndef HAL_I2C_M_EEPROM_MAX_PAGE_SIZE
+#define HAL_I2C_M_EEPROM_MAX_PAGE_SIZE    (64U)
+#endif
+
+/* A page write that has not been ACKed after this many tWR is a failure */
+#ifndef HAL_I2C_M_EEPROM_TIMEOUT_FACTOR
+#define HAL_I2C_M_EEPROM_TIMEOUT_FACTOR   (4UL)
+#endif
+
+typedef enum
+{
+    HAL_I2C_M_EEPROM_IDLE = 0,
+    HAL_I2C_M_EEPROM_BUSY,
+    HAL_I2C_M_EEPROM_DONE,
+    HAL_I2C_M_EEPROM_FAILED
+} hal_i2c_m_eeprom_status_t;
+
+/*
+ * EEPROM part description. Address bits above the in-band address bytes
+ * (24C04..24C16, 24CM02) are carried in the low bits of the device address.
+ */
+typedef struct
+{
+    uint8_t           address7;
+    uint8_t           address_bytes;   /* 1 or 2 */
+    uint16_t          page_size;
+    uint32_t          size_bytes;
+    uint32_t          write_cycle_us;  /* datasheet tWR */
+    hal_i2c_m_speed_t max_speed;
+} hal_i2c_m_eeprom_t;
+
+/* Datasheet presets, referenced by name from HAL_I2C_M_EEPROM_TABLE */
+#define HAL_I2C_M_EEPROM_PART_GENERIC(address7) \
+    { (address7), 2U, 16U, 65536UL, 5000UL, HAL_I2C_M_SPEED_STANDARD }
+#define HAL_I2C_M_EEPROM_PART_24C02(address7) \
+    { (address7), 1U, 8U, 256UL, 5000UL, HAL_I2C_M_SPEED_FAST }
+/* 400 kHz: only the FM/-F variants of the 24C256 are rated for 1 MHz */
+#define HAL_I2C_M_EEPROM_PART_24C256(address7) \
+    { (address7), 2U, 64U, 32768UL, 5000UL, HAL_I2C_M_SPEED_FAST }
+#define HAL_I2C_M_EEPROM_PART_24CM02(address7) \
+    { (address7), 2U, 256U, 262144UL, 10000UL, HAL_I2C_M_SPEED_FAST_PLUS }
+
+#include "hal_i2c_master_board.h"
+
+enum hal_i2c_m_eeprom_id_t
+{
+#define HAL_I2C_M_EEPROM_DECLARE_ENUM(name, address7, part) name,
+    HAL_I2C_M_EEPROM_TABLE(HAL_I2C_M_EEPROM_DECLARE_ENUM)
+#undef HAL_I2C_M_EEPROM_DECLARE_ENUM
+    HAL_I2C_M_EEPROM_COUNT
+};
+
+extern const hal_i2c_m_eeprom_t g_hal_i2c_m_eeprom_table[];
+
+/* Device handle for the EEPROM API */
+#define HAL_I2C_M_EEPROM(id)  (&g_hal_i2c_m_eeprom_table[(id)])
+
+/* Completion callback; runs in interrupt context with the IICA1 backend. */
+typedef void (*hal_i2c_m_callback_t)(bool success, void *context);
+
+/* Streaming read sink, called in thread context; return false to stop early. */
+typedef bool (*hal_i2c_m_chunk_fn_t)(const uint8_t *chunk, uint16_t length, void *context);
+
+/* Streaming write source: fill exactly length bytes; return false to stop. */
+typedef bool (*hal_i2c_m_fill_fn_t)(uint8_t *chunk, uint16_t length, void *context);
+
+/*
+ * Queued transaction: optional write phase followed by an optional read phase
+ * with a repeated start. Descriptor is copied on submit; buffers are not.
+ */
+typedef struct
+{
+    uint8_t        address;
+    const uint8_t *tx_data;
+    uint16_t       tx_length;
+    uint8_t       *rx_data;
+    uint16_t       rx_length;
+    void          *context;
+} hal_i2c_m_txn_t;
+
+void HAL_I2C_M_Init(void);
 
 bool HAL_I2C_M_Write(uint8_t address, const uint8_t *data, uint16_t length);
 bool HAL_I2C_M_Read(uint8_t address, uint8_t *data, uint16_t length);
@@ -15,8 +141,131 @@ bool HAL_I2C_M_WriteRead(uint8_t address,
                          uint16_t tx_length,
                          uint8_t *rx_data,
                          uint16_t rx_length);
+bool HAL_I2C_M_Probe(uint8_t address);
+
+/*
+ * Blocking write-then-read of rx_length bytes (up to 4 GiB) in a single
+ * transaction, delivered through chunk in pieces of chunk_size. The bus is
+ * held, SCL low, while the consumer runs, so memory use does not depend on
+ * rx_length.
+ */
+bool HAL_I2C_M_WriteReadStream(uint8_t address,
+                               const uint8_t *tx_data,
+                               uint16_t tx_length,
+                               uint32_t rx_length,
+                               uint8_t *chunk,
+                               uint16_t chunk_size,
+                               hal_i2c_m_chunk_fn_t consumer,
+                               void *context);
+
+/*
+ * Hold the master bus across several transfers. With the GPIO backend the
+ * slave peripheral is stopped and the pins taken over once at the outermost
+ * BeginSession and handed back at the matching EndSession, instead of around
+ * every transfer. Sessions nest. No-op with the IICA1 backend.
+ */
+bool HAL_I2C_M_BeginSession(void);
+void HAL_I2C_M_EndSession(void);
+
+/* Timing for the following transfers; rejected while a transfer is running. */
+bool HAL_I2C_M_SetBusSpeed(hal_i2c_m_speed_t speed);
+hal_i2c_m_speed_t HAL_I2C_M_GetBusSpeed(void);
+
+/*
+ * Start a transfer and return immediately. Buffers must stay valid until the
+ * callback runs. Returns false when the arguments are invalid or a transfer
+ * is already in progress; the callback then never runs. The GPIO backend
+ * completes the transfer and runs the callback before returning, so
+ * HAL_I2C_M_IsBusy always returns false there.
+ */
+bool HAL_I2C_M_WriteAsync(uint8_t address,
+                          const uint8_t *data,
+                          uint16_t length,
+                          hal_i2c_m_callback_t callback,
+                          void *context);
+bool HAL_I2C_M_ReadAsync(uint8_t address,
+                         uint8_t *data,
+                         uint16_t length,
+                         hal_i2c_m_callback_t callback,
+                         void *context);
+bool HAL_I2C_M_WriteReadAsync(uint8_t address,
+                              const uint8_t *tx_data,
+                              uint16_t tx_length,
+                              uint8_t *rx_data,
+                              uint16_t rx_length,
+                              hal_i2c_m_callback_t callback,
+                              void *context);
+bool HAL_I2C_M_IsBusy(void);
+
+/*
+ * Queue a transaction behind any already submitted and return immediately.
+ * The callback receives txn->context. With the IICA1 backend the queue chains
+ * itself from the completion interrupt; HAL_I2C_M_Service must still run
+ * periodically to retry starts that found the bus busy. The GPIO backend
+ * performs one queued transaction per HAL_I2C_M_Service call.
+ */
+bool HAL_I2C_M_Submit(const hal_i2c_m_txn_t *txn, hal_i2c_m_callback_t callback);
+uint8_t HAL_I2C_M_GetPendingCount(void);
+void HAL_I2C_M_Service(void);
+
+/* Transfer-complete interrupt body (INTIICA1). */
+void HAL_I2C_M_OnInterrupt(void);
+
+/*
+ * EEPROM access through a device handle. Writes are split at the part's page
+ * boundaries and run at its max_speed; the previous bus speed is restored.
+ */
+bool HAL_I2C_M_EEPROM_Write(const hal_i2c_m_eeprom_t *device,
+                            uint32_t memory_address,
+                            const uint8_t *data,
+                            uint16_t length);
+bool HAL_I2C_M_EEPROM_Read(const hal_i2c_m_eeprom_t *device,
+                           uint32_t memory_address,
+                           uint8_t *data,
+                           uint16_t length);
+
+/*
+ * Non-blocking page write driven by HAL_I2C_M_EEPROM_Task, which must be
+ * registered as a scheduler coroutine. The data buffer must stay valid until
+ * the callback, which runs once from the task and only for this write,
+ * reports the outcome. Returns false while another write is in progress or
+ * when an argument is invalid; the callback then never runs.
+ */
+bool HAL_I2C_M_EEPROM_WriteAsync(const hal_i2c_m_eeprom_t *device,
+                                 uint32_t memory_address,
+                                 const uint8_t *data,
+                                 uint16_t length,
+                                 hal_i2c_m_callback_t callback,
+                                 void *context);
+bool HAL_I2C_M_EEPROM_IsBusy(void);
+hal_sched_pt_status_t HAL_I2C_M_EEPROM_Task(hal_sched_pt_t *pt);
+
+/*
+ * Block until the part acknowledges its address again, e.g. to read while an
+ * asynchronous write is in its write cycle. False after the write timeout.
+ */
+bool HAL_I2C_M_EEPROM_WaitReady(const hal_i2c_m_eeprom_t *device);
+
+/*
+ * Whole-range EEPROM access with constant memory: the read is one sequential
+ * transaction per address block; the write asks the producer for one page at
+ * a time.
+ */
+bool HAL_I2C_M_EEPROM_ReadStream(const hal_i2c_m_eeprom_t *device,
+                                 uint32_t memory_address,
+                                 uint32_t length,
+                                 uint8_t *chunk,
+                                 uint16_t chunk_size,
+                                 hal_i2c_m_chunk_fn_t consumer,
+                                 void *context);
+bool HAL_I2C_M_EEPROM_WriteStream(const hal_i2c_m_eeprom_t *device,
+                                  uint32_t memory_address,
+                                  uint32_t length,
+                                  hal_i2c_m_fill_fn_t producer,
+                                  void *context);
 
-bool HAL_I2C_M_EEPROM_Write(uint16_t memory_address, const uint8_t *data, uint16_t length);
-bool HAL_I2C_M_EEPROM_Read(uint16_t memory_address, uint8_t *data, uint16_t length);
+/* Measured page write cycle, from the stop condition to the first ACK poll answered. */
+uint32_t HAL_I2C_M_EEPROM_GetLastWriteTimeUs(void);
+uint32_t HAL_I2C_M_EEPROM_GetMaxWriteTimeUs(void);
 
 #endif /* HAL_I2C_MASTER_H */
@@ -0,0 +1,20 @@
+#ifndef HAL_I2C_MASTER_BOARD_H
+#define HAL_I2C_MASTER_BOARD_H
+
+/*
+ * Define the board-specific EEPROM population by editing
+ * HAL_I2C_M_EEPROM_TABLE below. Each entry names a part preset from
+ * hal_i2c_master.h and its 7-bit base address (A2..A0 strapping included).
+ * Template:
+ *   #define HAL_I2C_M_EEPROM_TABLE(ENTRY) \
+ *       ENTRY(HAL_I2C_M_EEPROM_CALIBRATION, 0x50U, 24C02)  \
+ *       ENTRY(HAL_I2C_M_EEPROM_CONFIG,      0x51U, 24C256) \
+ *       ENTRY(HAL_I2C_M_EEPROM_LOG,         0x54U, 24CM02)
+ * A 24CM02 also answers on base + 1..3 (address bits 17:16).
+ */
+#ifndef HAL_I2C_M_EEPROM_TABLE
+#define HAL_I2C_M_EEPROM_TABLE(_ENTRY) \
+    _ENTRY(HAL_I2C_M_EEPROM_MAIN, 0x50U, GENERIC)
+#endif
+
+#endif /* HAL_I2C_MASTER_BOARD_H */
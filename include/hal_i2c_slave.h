@@ -20,6 +20,18 @@ typedef enum
     HAL_I2C_ERR_FRAME
 } hal_i2c_error_t;
 
+/*
+ * Slave recovery levels, each including the ones below it. Errors are
+ * answered in the ISR with the lightest level that clears them.
+ */
+typedef enum
+{
+    HAL_I2C_RECOVERY_NONE = 0,
+    HAL_I2C_RECOVERY_LIGHT,    /* drop the frame in progress, wait for the next START */
+    HAL_I2C_RECOVERY_MEDIUM,   /* also clear the response and re-arm slave receive */
+    HAL_I2C_RECOVERY_FULL      /* also Stop/Create/Start the peripheral */
+} hal_i2c_recovery_t;
+
 typedef struct
 {
     uint8_t  data[HAL_I2C_MESSAGE_MAX_BYTES];
@@ -30,16 +42,37 @@ typedef struct
 
 typedef struct
 {
-    hal_i2c_error_t code;
-    uint8_t         hw_status_flags;
-    bool            message_dropped;
-    uint32_t        timestamp_ms;
+    hal_i2c_error_t    code;
+    uint8_t            hw_status_flags;
+    bool               message_dropped;
+    uint32_t           timestamp_ms;
+    uint8_t            event_id;   /* pass to HAL_I2C_S_RecoverEvent */
+    hal_i2c_recovery_t recovery;   /* level already applied for this event */
 } hal_i2c_error_context_t;
 
+typedef struct
+{
+    uint32_t light;
+    uint32_t medium;
+    uint32_t full;
+    uint32_t coalesced;   /* RecoverEvent requests already covered */
+} hal_i2c_recovery_stats_t;
+
 typedef void (*hal_i2c_error_callback_t)(const hal_i2c_error_context_t *context);
 
 void HAL_I2C_S_Init(hal_i2c_error_callback_t error_cb);
+
+/* Full re-create, same as HAL_I2C_S_Recover(HAL_I2C_RECOVERY_FULL). */
 void HAL_I2C_S_Reset(void);
+void HAL_I2C_S_Recover(hal_i2c_recovery_t level);
+
+/*
+ * Recovery requested on behalf of a reported error. Skipped, and counted as
+ * coalesced, when the HAL already applied at least this level for the event
+ * or a newer error has since been handled. Returns true when it ran.
+ */
+bool HAL_I2C_S_RecoverEvent(uint8_t event_id, hal_i2c_recovery_t level);
+void HAL_I2C_S_GetRecoveryStats(hal_i2c_recovery_stats_t *stats);
 
 bool HAL_I2C_S_PopMessage(hal_i2c_message_t *message);
 
@@ -0,0 +1,59 @@
+#ifndef HAL_PROBE_H
+#define HAL_PROBE_H
+
+/*
+ * Timing probes: a spare pin is driven high on entry to an instrumented
+ * section and low on exit, so a logic analyzer shows ISR and task durations.
+ * Build with HAL_PROBE_ENABLE set to 1 and map the points in use to output
+ * pins of HAL_GPIO_PIN_TABLE in hal_gpio_board.h:
+ *
+ *   #define HAL_PROBE_PIN_TM00_ISR   HAL_GPIO_PIN_DEBUG0
+ *
+ * Writes go through the fixed-pin accessors, one set1/clr1 each. Unmapped
+ * points, and every point while probes are disabled, compile to nothing.
+ *
+ * Probe points:
+ *   TM00_ISR   tick interrupt
+ *   IICA0_ISR  IICA0 slave callbacks
+ *   TASK       each scheduler task run
+ */
+#ifndef HAL_PROBE_ENABLE
+#define HAL_PROBE_ENABLE  (0U)
+#endif
+
+#if HAL_PROBE_ENABLE
+
+#include "hal_gpio.h"
+#include "hal_gpio_board.h"
+#include "hal_gpio_pinmap.h"
+
+/* Stand-in pin for points the board leaves unmapped */
+static inline void hal_gpio_fast_write_HAL_PROBE_NO_PIN(hal_gpio_level_t level)
+{
+    (void)level;
+}
+
+#ifndef HAL_PROBE_PIN_TM00_ISR
+#define HAL_PROBE_PIN_TM00_ISR   HAL_PROBE_NO_PIN
+#endif
+#ifndef HAL_PROBE_PIN_IICA0_ISR
+#define HAL_PROBE_PIN_IICA0_ISR  HAL_PROBE_NO_PIN
+#endif
+#ifndef HAL_PROBE_PIN_TASK
+#define HAL_PROBE_PIN_TASK       HAL_PROBE_NO_PIN
+#endif
+
+/* Extra level so the mapped pin name is expanded before it is pasted */
+#define HAL_PROBE_WRITE(pin, level)  HAL_GPIO_WRITE_FAST(pin, level)
+
+#define HAL_PROBE_ENTER(point)  HAL_PROBE_WRITE(HAL_PROBE_PIN_##point, HAL_GPIO_LEVEL_HIGH)
+#define HAL_PROBE_EXIT(point)   HAL_PROBE_WRITE(HAL_PROBE_PIN_##point, HAL_GPIO_LEVEL_LOW)
+
+#else
+
+#define HAL_PROBE_ENTER(point)  ((void)0)
+#define HAL_PROBE_EXIT(point)   ((void)0)
+
+#endif /* HAL_PROBE_ENABLE */
+
+#endif /* HAL_PROBE_H */
@@ -1,21 +1,193 @@
 #ifndef HAL_SCHEDULER_H
 #define HAL_SCHEDULER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+/*
+ * Compile-time tick rate. With the default 1 kHz tick the millisecond uptime
+ * is the tick counter itself. Set to 0U to take the rate from HAL_SCHED_Init
+ * at run time; a millisecond counter is then maintained in the tick ISR.
+ */
+#ifndef HAL_SCHED_TICK_HZ
+#define HAL_SCHED_TICK_HZ  (1000U)
+#endif
+
+#ifndef HAL_SCHED_WORK_QUEUE_DEPTH
+#define HAL_SCHED_WORK_QUEUE_DEPTH  (8U)
+#endif
+
+/* Backlog bound for HAL_SCHED_OVERRUN_CATCH_UP; older periods are skipped. */
+#ifndef HAL_SCHED_CATCH_UP_MAX_PERIODS
+#define HAL_SCHED_CATCH_UP_MAX_PERIODS  (8U)
+#endif
+
+/*
+ * Auto-phasing spreads tasks over a window of ticks; periods that divide the
+ * window are placed exactly, longer ones are treated as firing once in it.
+ */
+#ifndef HAL_SCHED_PHASE_WINDOW_TICKS
+#define HAL_SCHED_PHASE_WINDOW_TICKS  (32U)
+#endif
+
+#define HAL_SCHED_PHASE_AUTO  (UINT16_MAX)
+
 typedef void (*hal_sched_task_fn_t)(void);
+typedef void (*hal_sched_work_fn_t)(uint16_t argument);
+
+typedef enum
+{
+    HAL_SCHED_PT_WAITING = 0,
+    HAL_SCHED_PT_YIELDED,
+    HAL_SCHED_PT_EXITED
+} hal_sched_pt_status_t;
+
+/*
+ * Stackless coroutine (protothread) context. Locals of a coroutine are not
+ * preserved across HAL_SCHED_PT_YIELD/WAIT points; keep state in static or
+ * caller-owned storage. A coroutine body must not contain its own switch
+ * statement around a yield point.
+ */
+typedef struct
+{
+    uint16_t resume_point;
+    uint32_t wake_tick;
+} hal_sched_pt_t;
+
+typedef hal_sched_pt_status_t (*hal_sched_pt_fn_t)(hal_sched_pt_t *pt);
+
+/*
+ * What to do with periods that elapsed while a task was late:
+ *  FIXED_RATE  - drop them, next deadline stays on the original phase grid
+ *  CATCH_UP    - run once per missed period (up to HAL_SCHED_CATCH_UP_MAX_PERIODS)
+ *  SKIP_TO_NOW - drop them and restart the period from the late run
+ */
+typedef enum
+{
+    HAL_SCHED_OVERRUN_FIXED_RATE = 0,
+    HAL_SCHED_OVERRUN_CATCH_UP,
+    HAL_SCHED_OVERRUN_SKIP_TO_NOW
+} hal_sched_overrun_policy_t;
 
 typedef struct
 {
-    hal_sched_task_fn_t function;
-    uint32_t            next_deadline;
-    uint16_t            period_ticks;
+    hal_sched_task_fn_t        function;
+    uint32_t                   next_deadline;
+    uint16_t                   period_ticks;
+    hal_sched_pt_fn_t          coroutine;
+    hal_sched_pt_t             pt;
+    hal_sched_overrun_policy_t overrun_policy;
+    uint16_t                   phase_ticks;        /* offset or HAL_SCHED_PHASE_AUTO */
+    uint16_t                   skipped_periods;    /* saturating */
+    uint16_t                   max_lateness_ticks; /* saturating */
+    uint16_t                   liveness_ticks;     /* check-in deadline, 0 = unmonitored */
+    uint32_t                   last_checkin;
 } hal_sched_task_t;
 
-void HAL_SCHED_Init(uint16_t tick_hz);
+/* Survives a watchdog reset in no-init RAM; valid when read back by the getter. */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t uptime_ms;
+    uint32_t silent_ticks;
+    uint8_t  task_index;
+    uint8_t  check;
+} hal_sched_starvation_record_t;
+
+/* Resume labels are reached by intentional fall-through from the code above. */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define HAL_SCHED_PT_FALLTHROUGH  __attribute__((fallthrough))
+#else
+#define HAL_SCHED_PT_FALLTHROUGH
+#endif
+
+#define HAL_SCHED_PT_INIT(pt)                                                  \
+    do                                                                         \
+    {                                                                          \
+        (pt)->resume_point = 0U;                                               \
+        (pt)->wake_tick    = 0UL;                                              \
+    } while (0)
+
+#define HAL_SCHED_PT_BEGIN(pt)                                                 \
+    switch ((pt)->resume_point)                                                \
+    {                                                                          \
+        case 0U:
+
+#define HAL_SCHED_PT_END(pt)                                                   \
+        default:                                                               \
+            break;                                                             \
+    }                                                                          \
+    (pt)->resume_point = 0U;                                                   \
+    return HAL_SCHED_PT_EXITED
+
+/* Resume on the next scheduler tick regardless of the task period. */
+#define HAL_SCHED_PT_YIELD(pt)                                                 \
+    do                                                                         \
+    {                                                                          \
+        (pt)->resume_point = (uint16_t)__LINE__;                               \
+        return HAL_SCHED_PT_YIELDED;                                           \
+        case __LINE__:;                                                        \
+    } while (0)
+
+/* Re-evaluate the condition every task period until it holds. */
+#define HAL_SCHED_PT_WAIT_UNTIL(pt, condition)                                 \
+    do                                                                         \
+    {                                                                          \
+        (pt)->resume_point = (uint16_t)__LINE__;                               \
+        HAL_SCHED_PT_FALLTHROUGH;                                              \
+        case __LINE__:                                                         \
+        if (!(condition))                                                      \
+        {                                                                      \
+            return HAL_SCHED_PT_WAITING;                                       \
+        }                                                                      \
+    } while (0)
+
+#define HAL_SCHED_PT_SLEEP(pt, ticks)                                          \
+    do                                                                         \
+    {                                                                          \
+        (pt)->wake_tick = HAL_SCHED_GetTicks() + (uint32_t)(ticks);            \
+        HAL_SCHED_PT_WAIT_UNTIL((pt), HAL_SCHED_IsTickDue((pt)->wake_tick));   \
+    } while (0)
+
+#define HAL_SCHED_PT_EXIT(pt)                                                  \
+    do                                                                         \
+    {                                                                          \
+        (pt)->resume_point = 0U;                                               \
+        return HAL_SCHED_PT_EXITED;                                            \
+    } while (0)
+
+/*
+ * tick_hz must match a non-zero HAL_SCHED_TICK_HZ; with HAL_SCHED_TICK_HZ 0U
+ * it is the run-time rate and must not be 0. Returns false, changing nothing,
+ * otherwise.
+ */
+bool HAL_SCHED_Init(uint16_t tick_hz);
 void HAL_SCHED_RegisterTasks(hal_sched_task_t *tasks, uint8_t task_count);
 void HAL_SCHED_TickISR(void);
 void HAL_SCHED_RunOnce(void);
 uint32_t HAL_SCHED_GetUptimeMs(void);
+/* Sub-tick resolution from the tick timer counter; wraps after ~71 minutes. */
+uint32_t HAL_SCHED_GetUptimeUs(void);
+uint32_t HAL_SCHED_GetTicks(void);
+bool HAL_SCHED_IsTickDue(uint32_t tick);
+
+/*
+ * Task supervisor. A monitored task calls HAL_SCHED_CheckIn from its own body;
+ * HAL_SCHED_SupervisorHealthy returns false once any monitored task has been
+ * silent for longer than its liveness_ticks, recording the first offender.
+ * Only refresh the watchdog while it returns true.
+ */
+void HAL_SCHED_CheckIn(void);
+bool HAL_SCHED_SupervisorHealthy(void);
+bool HAL_SCHED_GetStarvationRecord(hal_sched_starvation_record_t *record);
+void HAL_SCHED_ClearStarvationRecord(void);
+
+/*
+ * Queue a work item from any context (ISRs included). Items are executed in
+ * thread context at the start of the next HAL_SCHED_RunOnce. Returns false and
+ * counts a drop when the queue is full.
+ */
+bool HAL_SCHED_Defer(hal_sched_work_fn_t function, uint16_t argument);
+uint16_t HAL_SCHED_GetDeferDropCount(void);
 
 #endif /* HAL_SCHEDULER_H */
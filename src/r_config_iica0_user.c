@@ -1,27 +1,47 @@
 #include "hal_i2c_slave.h"
 #include "r_config_iica0.h"
+#include "hal_probe.h"
 
 void R_Config_IICA0_ResetBusLines(void)
 {
     /* Host-side build does not toggle physical bus lines. */
 }
 
+uint8_t R_Config_IICA0_SampleBusLines(void)
+{
+    /* Host-side build reports an idle bus. */
+    return (uint8_t)(R_IICA0_LINE_SDA | R_IICA0_LINE_SCL);
+}
+
+void R_Config_IICA0_ResetPeripheral(void)
+{
+    R_Config_IICA0_Stop();
+}
+
 void R_Config_IICA0_SlaveStartCallback(uint8_t status_flags)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnStartCondition(status_flags);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
 
 void R_Config_IICA0_SlaveReceiveCallback(uint8_t data_byte)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnByteReceived(data_byte);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
 
 void R_Config_IICA0_SlaveStopCallback(uint8_t status_flags)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnStopCondition(status_flags);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
 
 void R_Config_IICA0_ErrorCallback(uint8_t status_flags)
 {
+    HAL_PROBE_ENTER(IICA0_ISR);
     HAL_I2C_S_OnHardwareError(status_flags);
+    HAL_PROBE_EXIT(IICA0_ISR);
 }
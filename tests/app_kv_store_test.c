@@ -0,0 +1,401 @@
+/*
+ * Key/value store against the RAM EEPROM in mocks/mock_hal_eeprom.c. Reboots
+ * are modelled by calling APP_KV_Init again on the same memory.
+ *
+ *   cc -std=c99 -Wall -Wextra -Iinclude -Itests/mocks \
+ *       tests/app_kv_store_test.c tests/mocks/mock_hal_eeprom.c app/app_kv_store.c
+ */
+#include "app_kv_store.h"
+#include "mock_hal_eeprom.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_REGION_BASE  (0x0100UL)
+#define TEST_REGION_SIZE  (APP_KV_REGION_SIZE)
+#define TEST_BANK_RECORDS \
+    ((TEST_REGION_SIZE - (2UL * APP_KV_CHECKPOINT_SIZE)) / (2UL * APP_KV_RECORD_SIZE))
+
+static const hal_i2c_m_eeprom_t g_device = HAL_I2C_M_EEPROM_PART_GENERIC(0x50U);
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static bool test_boot(void)
+{
+    MOCK_HAL_EEPROM_ResetCounters();
+    return APP_KV_Init(&g_device, TEST_REGION_BASE, TEST_REGION_SIZE);
+}
+
+static void test_setup(void)
+{
+    MOCK_HAL_EEPROM_Reset(0xFFU);
+    (void)test_boot();
+}
+
+static bool test_value_is(uint8_t key, uint32_t expected)
+{
+    uint8_t value[APP_KV_VALUE_MAX];
+    uint8_t length = 0U;
+    uint32_t stored = 0UL;
+
+    if (!APP_KV_Get(key, value, (uint8_t)sizeof value, &length) || (length != sizeof stored))
+    {
+        return false;
+    }
+    memcpy(&stored, value, sizeof stored);
+
+    return (stored == expected);
+}
+
+/* The EEPROM task finishes any background checkpoint before the next call */
+static bool test_set(uint8_t key, uint32_t value)
+{
+    const bool stored = APP_KV_Set(key, (const uint8_t *)&value, (uint8_t)sizeof value);
+
+    MOCK_HAL_EEPROM_CompleteAsync();
+
+    return stored;
+}
+
+static void test_tear_checkpoint(uint32_t copy)
+{
+    MOCK_HAL_EEPROM_GetMemory()[TEST_REGION_BASE + (copy * APP_KV_CHECKPOINT_SIZE) + 20U] ^= 0x5AU;
+}
+
+/* Corrupt the checkpoint copy holding the highest generation */
+static void test_tear_newest_checkpoint(void)
+{
+    const uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+    uint32_t generation[2];
+
+    for (uint32_t copy = 0UL; copy < 2UL; copy++)
+    {
+        memcpy(&generation[copy], &memory[TEST_REGION_BASE + (copy * APP_KV_CHECKPOINT_SIZE)], sizeof generation[copy]);
+    }
+
+    test_tear_checkpoint((generation[1] > generation[0]) ? 1UL : 0UL);
+}
+
+static void test_blank_region_is_formatted(void)
+{
+    app_kv_stats_t stats;
+    uint8_t length = 0U;
+
+    MOCK_HAL_EEPROM_Reset(0xFFU);
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.keys == 0U);
+    TEST_ASSERT(stats.checkpoint_boot == false);
+    TEST_ASSERT(stats.checkpoints == 1UL);
+    TEST_ASSERT(APP_KV_Get(1U, NULL, 0U, &length) == false);
+
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.checkpoint_boot == true);
+    TEST_ASSERT(stats.keys == 0U);
+}
+
+static void test_values_survive_reboot(void)
+{
+    test_setup();
+    TEST_ASSERT(test_set(1U, 0x11111111UL) == true);
+    TEST_ASSERT(test_set(2U, 0x22222222UL) == true);
+    TEST_ASSERT(test_set(1U, 0x33333333UL) == true);
+    TEST_ASSERT(APP_KV_Delete(2U) == true);
+
+    TEST_ASSERT(test_boot() == true);
+    TEST_ASSERT(test_value_is(1U, 0x33333333UL) == true);
+    TEST_ASSERT(APP_KV_Get(2U, NULL, 0U, NULL) == false);
+}
+
+static void test_set_appends_one_record(void)
+{
+    test_setup();
+    TEST_ASSERT(test_set(7U, 1UL) == true);
+    MOCK_HAL_EEPROM_ResetCounters();
+    TEST_ASSERT(test_set(7U, 2UL) == true);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->writes == 1UL);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->bytes_written == APP_KV_RECORD_SIZE);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->reads == 0UL);
+
+    /* Unchanged value: nothing to write */
+    TEST_ASSERT(test_set(7U, 2UL) == true);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->writes == 1UL);
+}
+
+static void test_compaction_keeps_live_values(void)
+{
+    app_kv_stats_t stats;
+
+    test_setup();
+    TEST_ASSERT(test_set(9U, 0x99UL) == true);
+    for (uint32_t round = 0UL; round < (3UL * TEST_BANK_RECORDS); round++)
+    {
+        TEST_ASSERT(test_set(1U, round) == true);
+    }
+
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.compactions >= 2UL);
+    TEST_ASSERT(test_boot() == true);
+    TEST_ASSERT(test_value_is(1U, (3UL * TEST_BANK_RECORDS) - 1UL) == true);
+    TEST_ASSERT(test_value_is(9U, 0x99UL) == true);
+}
+
+static void test_boot_reads_checkpoint_instead_of_log(void)
+{
+    app_kv_stats_t stats;
+
+    test_setup();
+    for (uint8_t key = 0U; key < APP_KV_MAX_KEYS; key++)
+    {
+        TEST_ASSERT(test_set(key, key) == true);
+    }
+    for (uint32_t round = 0UL; round < 100UL; round++)
+    {
+        TEST_ASSERT(test_set((uint8_t)(round % 4U), round) == true);
+    }
+
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    const uint32_t checkpoint_bytes = MOCK_HAL_EEPROM_GetState()->bytes_read;
+
+    TEST_ASSERT(stats.checkpoint_boot == true);
+    TEST_ASSERT(test_value_is(3U, 99UL) == true);
+    TEST_ASSERT(test_value_is(15U, 15UL) == true);
+
+    /* Both copies damaged: the same state again, from a scan of the bank */
+    test_tear_checkpoint(0UL);
+    test_tear_checkpoint(1UL);
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    const uint32_t scan_bytes = MOCK_HAL_EEPROM_GetState()->bytes_read;
+
+    TEST_ASSERT(stats.checkpoint_boot == false);
+    TEST_ASSERT(test_value_is(3U, 99UL) == true);
+    TEST_ASSERT(test_value_is(15U, 15UL) == true);
+
+    printf("    boot read %u bytes from the checkpoint, %u with a full scan\n",
+           (unsigned)checkpoint_bytes, (unsigned)scan_bytes);
+
+    /* Checkpoint copy, two bank headers and at most one bank life of replay */
+    TEST_ASSERT(checkpoint_bytes <= (APP_KV_CHECKPOINT_SIZE + 8UL +
+                                     ((TEST_BANK_RECORDS - APP_KV_MAX_KEYS + 2UL) * APP_KV_RECORD_SIZE)));
+    TEST_ASSERT(scan_bytes >= (TEST_BANK_RECORDS * APP_KV_RECORD_SIZE));
+    TEST_ASSERT(checkpoint_bytes < scan_bytes);
+}
+
+static void test_torn_checkpoint_uses_older_copy(void)
+{
+    app_kv_stats_t stats;
+
+    test_setup();
+    TEST_ASSERT(test_set(1U, 10UL) == true);
+    TEST_ASSERT(APP_KV_Checkpoint() == true);
+    TEST_ASSERT(test_set(1U, 20UL) == true);
+    TEST_ASSERT(test_set(2U, 30UL) == true);
+    TEST_ASSERT(APP_KV_Checkpoint() == true);
+
+    test_tear_newest_checkpoint();
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.checkpoint_boot == true);
+    /* Replayed from the log on top of the older copy */
+    TEST_ASSERT(test_value_is(1U, 20UL) == true);
+    TEST_ASSERT(test_value_is(2U, 30UL) == true);
+
+    /* The next checkpoint goes over the torn copy */
+    TEST_ASSERT(APP_KV_Checkpoint() == true);
+    test_tear_newest_checkpoint();
+    TEST_ASSERT(test_boot() == true);
+    TEST_ASSERT(test_value_is(2U, 30UL) == true);
+}
+
+static void test_interrupted_compaction_keeps_previous_bank(void)
+{
+    app_kv_stats_t stats;
+    uint32_t fill = 0UL;
+
+    test_setup();
+    TEST_ASSERT(test_set(5U, 0x55UL) == true);
+    APP_KV_GetStats(&stats);
+    while (stats.free_records > 0U)
+    {
+        TEST_ASSERT(test_set(1U, fill++) == true);
+        APP_KV_GetStats(&stats);
+    }
+    const uint8_t bank = stats.active_bank;
+
+    /* Power lost after the first copy into the other bank */
+    MOCK_HAL_EEPROM_FailWritesAfter(1UL);
+    TEST_ASSERT(test_set(1U, 0xDEADUL) == false);
+
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.active_bank == bank);
+    TEST_ASSERT(test_value_is(1U, fill - 1UL) == true);
+    TEST_ASSERT(test_value_is(5U, 0x55UL) == true);
+
+    TEST_ASSERT(test_set(1U, 0xBEEFUL) == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.active_bank != bank);
+    TEST_ASSERT(test_boot() == true);
+    TEST_ASSERT(test_value_is(1U, 0xBEEFUL) == true);
+    TEST_ASSERT(test_value_is(5U, 0x55UL) == true);
+}
+
+static void test_stale_checkpoint_after_compaction_forces_scan(void)
+{
+    app_kv_stats_t stats;
+    uint32_t fill = 0UL;
+
+    test_setup();
+    TEST_ASSERT(test_set(5U, 0x55UL) == true);
+    APP_KV_GetStats(&stats);
+    while (stats.free_records > 0U)
+    {
+        TEST_ASSERT(test_set(1U, fill++) == true);
+        APP_KV_GetStats(&stats);
+    }
+
+    /* The copies and the bank header land; the checkpoint and the new value do not */
+    MOCK_HAL_EEPROM_FailWritesAfter(3UL);
+    TEST_ASSERT(test_set(1U, 0xCAFEUL) == false);
+
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.checkpoint_boot == false);
+    TEST_ASSERT(test_value_is(1U, fill - 1UL) == true);
+    TEST_ASSERT(test_value_is(5U, 0x55UL) == true);
+}
+
+static void test_failed_checkpoint_retried_on_next_append(void)
+{
+    app_kv_stats_t stats;
+    uint32_t fill = 0UL;
+
+    test_setup();
+    TEST_ASSERT(test_set(5U, 0x55UL) == true);
+    APP_KV_GetStats(&stats);
+    while (stats.free_records > 0U)
+    {
+        TEST_ASSERT(test_set(1U, fill++) == true);
+        APP_KV_GetStats(&stats);
+    }
+
+    /* Compaction lands, the background checkpoint after it does not */
+    MOCK_HAL_EEPROM_FailWritesAfter(3UL);
+    TEST_ASSERT(test_set(1U, 0xCAFEUL) == false);
+    MOCK_HAL_EEPROM_FailWritesAfter(UINT32_MAX);
+    TEST_ASSERT(test_set(1U, 0xCAFEUL) == true);
+
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.checkpoint_boot == true);
+    TEST_ASSERT(test_value_is(1U, 0xCAFEUL) == true);
+    TEST_ASSERT(test_value_is(5U, 0x55UL) == true);
+}
+
+static void test_checkpoint_written_in_background_once_per_bank(void)
+{
+    app_kv_stats_t stats;
+    app_kv_stats_t before;
+    uint32_t value = 0UL;
+
+    test_setup();
+    APP_KV_GetStats(&before);
+
+    /* Fill the bank with raw Set calls: the compaction checkpoint stays queued */
+    while (before.free_records > 0U)
+    {
+        TEST_ASSERT(test_set(1U, value++) == true);
+        APP_KV_GetStats(&before);
+    }
+    MOCK_HAL_EEPROM_ResetCounters();
+    TEST_ASSERT(APP_KV_Set(1U, (const uint8_t *)&value, (uint8_t)sizeof value) == true);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->async_writes == 1UL);
+    /* The append behind the compaction waited out the page in flight */
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->ready_waits == 1UL);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.compactions == (before.compactions + 1UL));
+    TEST_ASSERT(stats.checkpoints == before.checkpoints);
+
+    /* Counted once the writer is done with it */
+    MOCK_HAL_EEPROM_CompleteAsync();
+    TEST_ASSERT(test_set(2U, 2UL) == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.checkpoints == (before.checkpoints + 1UL));
+
+    /* Neither copy is written more often than a log slot */
+    for (uint32_t round = 0UL; round < (4UL * TEST_BANK_RECORDS); round++)
+    {
+        TEST_ASSERT(test_set(3U, round) == true);
+    }
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.checkpoints <= (stats.compactions + 1UL));
+    TEST_ASSERT(test_boot() == true);
+    APP_KV_GetStats(&stats);
+    TEST_ASSERT(stats.checkpoint_boot == true);
+    TEST_ASSERT(test_value_is(3U, (4UL * TEST_BANK_RECORDS) - 1UL) == true);
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "blank_region_is_formatted", test_blank_region_is_formatted },
+    { "values_survive_reboot", test_values_survive_reboot },
+    { "set_appends_one_record", test_set_appends_one_record },
+    { "compaction_keeps_live_values", test_compaction_keeps_live_values },
+    { "boot_reads_checkpoint_instead_of_log", test_boot_reads_checkpoint_instead_of_log },
+    { "torn_checkpoint_uses_older_copy", test_torn_checkpoint_uses_older_copy },
+    { "interrupted_compaction_keeps_previous_bank", test_interrupted_compaction_keeps_previous_bank },
+    { "stale_checkpoint_after_compaction_forces_scan", test_stale_checkpoint_after_compaction_forces_scan },
+    { "failed_checkpoint_retried_on_next_append", test_failed_checkpoint_retried_on_next_append },
+    { "checkpoint_written_in_background_once_per_bank", test_checkpoint_written_in_background_once_per_bank }
+};
+
+int main(void)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
@@ -0,0 +1,284 @@
+/*
+ * EEPROM write-back cache against the RAM EEPROM in mocks/mock_hal_eeprom.c.
+ * Background flushes finish when the test calls MOCK_HAL_EEPROM_CompleteAsync.
+ *
+ *   cc -std=c99 -Wall -Wextra -Iinclude -Itests/mocks \
+ *       tests/hal_eeprom_cache_test.c tests/mocks/mock_hal_eeprom.c \
+ *       tests/mocks/mock_hal_scheduler.c app/hal_eeprom_cache.c
+ */
+#include "hal_eeprom_cache.h"
+#include "mock_hal_eeprom.h"
+#include "mock_hal_scheduler.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_LINE(n)  ((uint32_t)(n) * HAL_EEPROM_CACHE_LINE_SIZE)
+
+static const hal_i2c_m_eeprom_t g_device = HAL_I2C_M_EEPROM_PART_GENERIC(0x50U);
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static void test_setup(void)
+{
+    uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+
+    MOCK_HAL_EEPROM_Reset(0xFFU);
+    MOCK_HAL_SCHED_Reset();
+    for (uint32_t index = 0UL; index < g_device.size_bytes; index++)
+    {
+        memory[index] = (uint8_t)(index ^ (index >> 8));
+    }
+    (void)HAL_EEPROM_CACHE_Init(&g_device);
+}
+
+static hal_eeprom_cache_stats_t test_stats(void)
+{
+    hal_eeprom_cache_stats_t stats;
+
+    HAL_EEPROM_CACHE_GetStats(&stats);
+
+    return stats;
+}
+
+static bool test_read_byte_is(uint32_t address, uint8_t expected)
+{
+    uint8_t value = 0U;
+
+    return HAL_EEPROM_CACHE_Read(address, &value, 1U) && (value == expected);
+}
+
+/* Dirty the line holding address and let the idle task start writing it back */
+static bool test_start_background_flush(uint32_t address, uint8_t value)
+{
+    if (!HAL_EEPROM_CACHE_Write(address, &value, 1U))
+    {
+        return false;
+    }
+
+    MOCK_HAL_SCHED_Advance(HAL_EEPROM_CACHE_IDLE_FLUSH_MS);
+    HAL_EEPROM_CACHE_IdleTask();
+
+    return HAL_I2C_M_EEPROM_IsBusy();
+}
+
+static void test_record_outcome(bool success, void *context)
+{
+    *(hal_i2c_m_eeprom_status_t *)context = success ? HAL_I2C_M_EEPROM_DONE : HAL_I2C_M_EEPROM_FAILED;
+}
+
+static void test_init_rejects_line_larger_than_page(void)
+{
+    static const hal_i2c_m_eeprom_t small_pages = HAL_I2C_M_EEPROM_PART_24C02(0x50U);
+
+    MOCK_HAL_EEPROM_Reset(0xFFU);
+    TEST_ASSERT(HAL_EEPROM_CACHE_Init(NULL) == false);
+    TEST_ASSERT(HAL_EEPROM_CACHE_Init(&small_pages) == (HAL_EEPROM_CACHE_LINE_SIZE <= 8U));
+    TEST_ASSERT(HAL_EEPROM_CACHE_Init(&g_device) == true);
+}
+
+static void test_read_hits_and_misses(void)
+{
+    test_setup();
+    uint8_t buffer[20];
+
+    /* Spans two lines */
+    TEST_ASSERT(HAL_EEPROM_CACHE_Read(TEST_LINE(1) + 4U, buffer, (uint16_t)sizeof buffer) == true);
+    TEST_ASSERT(memcmp(buffer, &MOCK_HAL_EEPROM_GetMemory()[TEST_LINE(1) + 4U], sizeof buffer) == 0);
+    TEST_ASSERT(test_stats().read_misses == 2U);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->reads == 2U);
+
+    TEST_ASSERT(HAL_EEPROM_CACHE_Read(TEST_LINE(1), buffer, 4U) == true);
+    TEST_ASSERT(memcmp(buffer, &MOCK_HAL_EEPROM_GetMemory()[TEST_LINE(1)], 4U) == 0);
+    TEST_ASSERT(test_stats().read_hits == 1U);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->reads == 2U);
+}
+
+static void test_lru_evicts_least_recent_line(void)
+{
+    test_setup();
+    const uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+
+    for (uint32_t line = 0UL; line < HAL_EEPROM_CACHE_LINES; line++)
+    {
+        TEST_ASSERT(test_read_byte_is(TEST_LINE(line), memory[TEST_LINE(line)]));
+    }
+
+    /* Line 0 becomes the most recent, so line 1 is the victim */
+    TEST_ASSERT(test_read_byte_is(TEST_LINE(0), memory[TEST_LINE(0)]));
+    TEST_ASSERT(test_read_byte_is(TEST_LINE(HAL_EEPROM_CACHE_LINES), memory[TEST_LINE(HAL_EEPROM_CACHE_LINES)]));
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->reads == (HAL_EEPROM_CACHE_LINES + 1U));
+
+    TEST_ASSERT(test_read_byte_is(TEST_LINE(0), memory[TEST_LINE(0)]));
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->reads == (HAL_EEPROM_CACHE_LINES + 1U));
+    TEST_ASSERT(test_read_byte_is(TEST_LINE(1), memory[TEST_LINE(1)]));
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->reads == (HAL_EEPROM_CACHE_LINES + 2U));
+}
+
+static void test_dirty_span_written_on_flush_and_eviction(void)
+{
+    test_setup();
+    const uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+    static const uint8_t pattern[4] = { 0xA1U, 0xA2U, 0xA3U, 0xA4U };
+
+    TEST_ASSERT(HAL_EEPROM_CACHE_Write(TEST_LINE(2) + 6U, pattern, (uint16_t)sizeof pattern) == true);
+    TEST_ASSERT(memcmp(&memory[TEST_LINE(2) + 6U], pattern, sizeof pattern) != 0);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->writes == 0U);
+
+    TEST_ASSERT(HAL_EEPROM_CACHE_Flush() == true);
+    TEST_ASSERT(memcmp(&memory[TEST_LINE(2) + 6U], pattern, sizeof pattern) == 0);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->bytes_written == sizeof pattern);
+    TEST_ASSERT(HAL_EEPROM_CACHE_Flush() == true);
+    TEST_ASSERT(test_stats().page_writes == 1U);
+
+    /* A dirty line pushed out by misses is written back first */
+    TEST_ASSERT(HAL_EEPROM_CACHE_Write(TEST_LINE(3), pattern, 1U) == true);
+    for (uint32_t line = 4UL; line < (4UL + HAL_EEPROM_CACHE_LINES); line++)
+    {
+        TEST_ASSERT(test_read_byte_is(TEST_LINE(line), memory[TEST_LINE(line)]));
+    }
+    TEST_ASSERT(memory[TEST_LINE(3)] == pattern[0]);
+    TEST_ASSERT(test_stats().page_writes == 2U);
+}
+
+static void test_idle_flush_after_quiet_period(void)
+{
+    test_setup();
+    const uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+    const uint8_t value = 0x3CU;
+
+    TEST_ASSERT(HAL_EEPROM_CACHE_Write(TEST_LINE(5), &value, 1U) == true);
+    HAL_EEPROM_CACHE_IdleTask();
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->async_writes == 0U);
+
+    MOCK_HAL_SCHED_Advance(HAL_EEPROM_CACHE_IDLE_FLUSH_MS);
+    HAL_EEPROM_CACHE_IdleTask();
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->async_writes == 1U);
+    TEST_ASSERT(memory[TEST_LINE(5)] != value);
+
+    MOCK_HAL_EEPROM_CompleteAsync();
+    HAL_EEPROM_CACHE_IdleTask();
+    TEST_ASSERT(memory[TEST_LINE(5)] == value);
+    TEST_ASSERT(test_stats().page_writes == 1U);
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->async_writes == 1U);
+}
+
+static void test_miss_during_background_flush_waits(void)
+{
+    test_setup();
+    const uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+    const uint8_t value = 0x77U;
+
+    TEST_ASSERT(test_start_background_flush(TEST_LINE(0), 0x11U));
+
+    TEST_ASSERT(test_read_byte_is(TEST_LINE(7) + 3U, memory[TEST_LINE(7) + 3U]));
+    TEST_ASSERT(MOCK_HAL_EEPROM_GetState()->ready_waits == 1U);
+    TEST_ASSERT(HAL_EEPROM_CACHE_Write(TEST_LINE(8) + 1U, &value, 1U) == true);
+
+    MOCK_HAL_EEPROM_CompleteAsync();
+    TEST_ASSERT(HAL_EEPROM_CACHE_Flush() == true);
+    TEST_ASSERT(memory[TEST_LINE(0)] == 0x11U);
+    TEST_ASSERT(memory[TEST_LINE(8) + 1U] == value);
+}
+
+static void test_write_during_flush_is_kept(void)
+{
+    test_setup();
+    const uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+    const uint8_t later = 0x22U;
+
+    TEST_ASSERT(test_start_background_flush(TEST_LINE(1) + 2U, 0x11U));
+    TEST_ASSERT(HAL_EEPROM_CACHE_Write(TEST_LINE(1) + 9U, &later, 1U) == true);
+    TEST_ASSERT(HAL_EEPROM_CACHE_Flush() == false);
+
+    MOCK_HAL_EEPROM_CompleteAsync();
+    TEST_ASSERT(HAL_EEPROM_CACHE_Flush() == true);
+    TEST_ASSERT(memory[TEST_LINE(1) + 2U] == 0x11U);
+    TEST_ASSERT(memory[TEST_LINE(1) + 9U] == later);
+    TEST_ASSERT(test_stats().page_writes == 2U);
+    TEST_ASSERT(test_read_byte_is(TEST_LINE(1) + 9U, later));
+}
+
+static void test_failed_flush_survives_other_writer(void)
+{
+    test_setup();
+    const uint8_t *memory = MOCK_HAL_EEPROM_GetMemory();
+    static const uint8_t other = 0x5AU;
+    hal_i2c_m_eeprom_status_t other_status = HAL_I2C_M_EEPROM_BUSY;
+
+    TEST_ASSERT(test_start_background_flush(TEST_LINE(4), 0x66U));
+    MOCK_HAL_EEPROM_FailWritesAfter(0U);
+    MOCK_HAL_EEPROM_CompleteAsync();
+    MOCK_HAL_EEPROM_FailWritesAfter(UINT32_MAX);
+
+    /* Another client's job succeeds before the cache looks at its own */
+    TEST_ASSERT(HAL_I2C_M_EEPROM_WriteAsync(&g_device, TEST_LINE(20), &other, 1U,
+                                            test_record_outcome, &other_status) == true);
+    MOCK_HAL_EEPROM_CompleteAsync();
+    TEST_ASSERT(other_status == HAL_I2C_M_EEPROM_DONE);
+
+    TEST_ASSERT(HAL_EEPROM_CACHE_Flush() == true);
+    TEST_ASSERT(memory[TEST_LINE(4)] == 0x66U);
+    TEST_ASSERT(memory[TEST_LINE(20)] == other);
+    TEST_ASSERT(test_stats().page_writes == 1U);
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "init_rejects_line_larger_than_page", test_init_rejects_line_larger_than_page },
+    { "read_hits_and_misses", test_read_hits_and_misses },
+    { "lru_evicts_least_recent_line", test_lru_evicts_least_recent_line },
+    { "dirty_span_written_on_flush_and_eviction", test_dirty_span_written_on_flush_and_eviction },
+    { "idle_flush_after_quiet_period", test_idle_flush_after_quiet_period },
+    { "miss_during_background_flush_waits", test_miss_during_background_flush_waits },
+    { "write_during_flush_is_kept", test_write_during_flush_is_kept },
+    { "failed_flush_survives_other_writer", test_failed_flush_survives_other_writer }
+};
+
+int main(void)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+/*
+ * Debounced GPIO inputs on the host board in mocks/hal_gpio_board.h.
+ *
+ *   cc -std=c99 -Wall -Wextra -Itests/mocks -Iinclude \
+ *       tests/hal_gpio_input_test.c tests/mocks/mock_gpio_ports.c \
+ *       app/hal_gpio.c app/hal_gpio_input.c
+ */
+#include "hal_gpio_input.h"
+#include "hal_gpio_board.h"
+#include "hal_gpio_pinmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_RECORDED_EDGES (16U)
+
+#define TEST_BUTTON_MASK   ((uint8_t)(1U << 0))
+#define TEST_DOOR_MASK     ((uint8_t)(1U << 1))
+#define TEST_SENSOR_MASK   ((uint8_t)(1U << 4))
+
+typedef struct
+{
+    hal_gpio_pin_id_t pin;
+    hal_gpio_edge_t   edge;
+} test_edge_t;
+
+static test_edge_t g_edges[MAX_RECORDED_EDGES];
+static uint32_t g_edge_count = 0U;
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+
+static void test_record_edge(hal_gpio_pin_id_t pin, hal_gpio_edge_t edge)
+{
+    if (g_edge_count < MAX_RECORDED_EDGES)
+    {
+        g_edges[g_edge_count].pin  = pin;
+        g_edges[g_edge_count].edge = edge;
+    }
+
+    g_edge_count++;
+}
+
+/* Button released (pulled high), door closed (low), sensor low */
+static void test_setup(void)
+{
+    MOCK_P0  = TEST_BUTTON_MASK;
+    MOCK_PM0 = 0U;
+    MOCK_PU0 = 0U;
+    MOCK_P1  = 0U;
+    MOCK_PM1 = 0U;
+    memset(g_edges, 0, sizeof g_edges);
+    g_edge_count = 0U;
+    HAL_GPIO_Init();
+    (void)HAL_GPIO_INPUT_Init();
+}
+
+static void test_run(uint8_t samples)
+{
+    for (uint8_t count = 0U; count < samples; count++)
+    {
+        HAL_GPIO_INPUT_Task();
+    }
+}
+
+static hal_gpio_level_t test_level(hal_gpio_pin_id_t pin)
+{
+    hal_gpio_level_t level = HAL_GPIO_LEVEL_LOW;
+
+    (void)HAL_GPIO_INPUT_Read(pin, &level);
+
+    return level;
+}
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static void test_init_seeds_state_without_edges(void)
+{
+    test_setup();
+    hal_gpio_input_stats_t stats;
+    hal_gpio_level_t level;
+
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR), HAL_GPIO_EDGE_BOTH, test_record_edge));
+    test_run(8U);
+    HAL_GPIO_INPUT_GetStats(&stats);
+
+    TEST_ASSERT(stats.ports == 2U);
+    TEST_ASSERT(stats.samples == 8U);
+    TEST_ASSERT(stats.edges == 0U);
+    TEST_ASSERT(g_edge_count == 0U);
+    TEST_ASSERT(test_level(HAL_GPIO_PIN_BUTTON) == HAL_GPIO_LEVEL_LOW);
+    TEST_ASSERT(test_level(HAL_GPIO_PIN_DOOR) == HAL_GPIO_LEVEL_LOW);
+    TEST_ASSERT(HAL_GPIO_INPUT_Read(HAL_GPIO_PIN_LED, &level) == false);
+}
+
+static void test_change_needs_four_samples(void)
+{
+    test_setup();
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR), HAL_GPIO_EDGE_BOTH, test_record_edge));
+
+    MOCK_GPIO_Drive(&MOCK_P0, TEST_DOOR_MASK, true);
+    test_run(3U);
+    TEST_ASSERT(g_edge_count == 0U);
+    TEST_ASSERT(test_level(HAL_GPIO_PIN_DOOR) == HAL_GPIO_LEVEL_LOW);
+
+    test_run(1U);
+    TEST_ASSERT(g_edge_count == 1U);
+    TEST_ASSERT(g_edges[0].pin == HAL_GPIO_PIN_DOOR);
+    TEST_ASSERT(g_edges[0].edge == HAL_GPIO_EDGE_RISING);
+    TEST_ASSERT(test_level(HAL_GPIO_PIN_DOOR) == HAL_GPIO_LEVEL_HIGH);
+
+    MOCK_GPIO_Drive(&MOCK_P0, TEST_DOOR_MASK, false);
+    test_run(4U);
+    TEST_ASSERT(g_edge_count == 2U);
+    TEST_ASSERT(g_edges[1].edge == HAL_GPIO_EDGE_FALLING);
+}
+
+static void test_bounce_is_filtered(void)
+{
+    test_setup();
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR), HAL_GPIO_EDGE_BOTH, test_record_edge));
+
+    /* Contact chatter: never four samples in a row at the new level */
+    for (uint8_t cycle = 0U; cycle < 10U; cycle++)
+    {
+        MOCK_GPIO_Drive(&MOCK_P0, TEST_DOOR_MASK, true);
+        test_run((uint8_t)(1U + (cycle % 3U)));
+        MOCK_GPIO_Drive(&MOCK_P0, TEST_DOOR_MASK, false);
+        test_run(1U);
+    }
+
+    TEST_ASSERT(g_edge_count == 0U);
+    TEST_ASSERT(test_level(HAL_GPIO_PIN_DOOR) == HAL_GPIO_LEVEL_LOW);
+}
+
+static void test_inverted_pin_and_edge_filter(void)
+{
+    test_setup();
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_BUTTON), HAL_GPIO_EDGE_RISING, test_record_edge));
+
+    /* Active-low button: pulling the pin down is a logical rising edge */
+    MOCK_GPIO_Drive(&MOCK_P0, TEST_BUTTON_MASK, false);
+    test_run(4U);
+    TEST_ASSERT(g_edge_count == 1U);
+    TEST_ASSERT(g_edges[0].pin == HAL_GPIO_PIN_BUTTON);
+    TEST_ASSERT(g_edges[0].edge == HAL_GPIO_EDGE_RISING);
+    TEST_ASSERT(test_level(HAL_GPIO_PIN_BUTTON) == HAL_GPIO_LEVEL_HIGH);
+
+    /* Release: debounced, but not subscribed */
+    MOCK_GPIO_Drive(&MOCK_P0, TEST_BUTTON_MASK, true);
+    test_run(4U);
+    TEST_ASSERT(g_edge_count == 1U);
+    TEST_ASSERT(test_level(HAL_GPIO_PIN_BUTTON) == HAL_GPIO_LEVEL_LOW);
+}
+
+static void test_ports_debounce_in_parallel(void)
+{
+    test_setup();
+    const hal_gpio_group_t all = HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_BUTTON) | HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR) |
+                                 HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_SENSOR);
+    hal_gpio_input_stats_t stats;
+
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(all, HAL_GPIO_EDGE_BOTH, test_record_edge));
+
+    MOCK_GPIO_Drive(&MOCK_P0, TEST_BUTTON_MASK, false);
+    MOCK_GPIO_Drive(&MOCK_P0, TEST_DOOR_MASK, true);
+    test_run(1U);
+    MOCK_GPIO_Drive(&MOCK_P1, TEST_SENSOR_MASK, true);
+    test_run(3U);
+
+    /* Both pins of P0 settle on the same sample; the sensor one later */
+    TEST_ASSERT(g_edge_count == 2U);
+    TEST_ASSERT(g_edges[0].pin == HAL_GPIO_PIN_BUTTON);
+    TEST_ASSERT(g_edges[1].pin == HAL_GPIO_PIN_DOOR);
+
+    test_run(1U);
+    TEST_ASSERT(g_edge_count == 3U);
+    TEST_ASSERT(g_edges[2].pin == HAL_GPIO_PIN_SENSOR);
+    TEST_ASSERT(g_edges[2].edge == HAL_GPIO_EDGE_RISING);
+
+    HAL_GPIO_INPUT_GetStats(&stats);
+    TEST_ASSERT(stats.edges == 3U);
+}
+
+static void test_subscribe_rejects_non_inputs(void)
+{
+    test_setup();
+
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_LED), HAL_GPIO_EDGE_BOTH, test_record_edge) == false);
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_COUNT), HAL_GPIO_EDGE_BOTH, test_record_edge) == false);
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR), HAL_GPIO_EDGE_BOTH, NULL) == false);
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR), (hal_gpio_edge_t)0, test_record_edge) == false);
+
+    for (uint8_t count = 0U; count < HAL_GPIO_INPUT_MAX_SUBSCRIBERS; count++)
+    {
+        TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR), HAL_GPIO_EDGE_BOTH, test_record_edge));
+    }
+    TEST_ASSERT(HAL_GPIO_INPUT_Subscribe(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR), HAL_GPIO_EDGE_BOTH, test_record_edge) == false);
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "init_seeds_state_without_edges", test_init_seeds_state_without_edges },
+    { "change_needs_four_samples", test_change_needs_four_samples },
+    { "bounce_is_filtered", test_bounce_is_filtered },
+    { "inverted_pin_and_edge_filter", test_inverted_pin_and_edge_filter },
+    { "ports_debounce_in_parallel", test_ports_debounce_in_parallel },
+    { "subscribe_rejects_non_inputs", test_subscribe_rejects_non_inputs }
+};
+
+int main(void)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+/*
+ * GPIO table API on the host board in mocks/hal_gpio_board.h.
+ *
+ *   cc -std=c99 -Wall -Wextra -Itests/mocks -Iinclude \
+ *       tests/hal_gpio_test.c tests/mocks/mock_gpio_ports.c app/hal_gpio.c
+ */
+#include "hal_gpio.h"
+#include "hal_gpio_board.h"
+#include "hal_gpio_pinmap.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_BUTTON_MASK   ((uint8_t)(1U << 0))
+#define TEST_DOOR_MASK     ((uint8_t)(1U << 1))
+#define TEST_LED_MASK      ((uint8_t)(1U << 7))
+#define TEST_SENSOR_MASK   ((uint8_t)(1U << 4))
+
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+
+static void test_setup(void)
+{
+    MOCK_P0  = 0U;
+    MOCK_PM0 = 0U;
+    MOCK_PU0 = 0U;
+    MOCK_P1  = 0U;
+    MOCK_PM1 = 0U;
+    HAL_GPIO_Init();
+}
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static void test_init_applies_table_defaults(void)
+{
+    test_setup();
+
+    TEST_ASSERT(HAL_GPIO_PinCount() == (uint8_t)HAL_GPIO_PIN_COUNT);
+    TEST_ASSERT(HAL_GPIO_IsValid(HAL_GPIO_PIN_SENSOR) == true);
+    TEST_ASSERT(HAL_GPIO_IsValid(HAL_GPIO_PIN_COUNT) == false);
+    TEST_ASSERT((MOCK_PM0 & (TEST_BUTTON_MASK | TEST_DOOR_MASK)) == (TEST_BUTTON_MASK | TEST_DOOR_MASK));
+    TEST_ASSERT((MOCK_PM0 & TEST_LED_MASK) == 0U);
+    TEST_ASSERT(MOCK_PU0 == TEST_BUTTON_MASK);
+    TEST_ASSERT((MOCK_PM1 & TEST_SENSOR_MASK) == TEST_SENSOR_MASK);
+}
+
+static void test_group_write_and_read(void)
+{
+    test_setup();
+    const hal_gpio_group_t inputs = HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_BUTTON) | HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_DOOR) |
+                                    HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_SENSOR);
+    hal_gpio_group_t levels = 0U;
+
+    TEST_ASSERT(HAL_GPIO_WriteGroup(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_LED), HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_LED)));
+    TEST_ASSERT(MOCK_P0 == TEST_LED_MASK);
+
+    /* The button is active low: a low pin reads as HIGH */
+    MOCK_P1 = TEST_SENSOR_MASK;
+    TEST_ASSERT(HAL_GPIO_ReadGroup(inputs, &levels));
+    TEST_ASSERT(levels == (HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_BUTTON) | HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_SENSOR)));
+
+    /* A bad pin in the group leaves every port untouched */
+    TEST_ASSERT(HAL_GPIO_WriteGroup(HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_LED) | HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_COUNT), 0U) == false);
+    TEST_ASSERT(MOCK_P0 == TEST_LED_MASK);
+}
+
+static void test_toggle_flips_latch(void)
+{
+    test_setup();
+
+    TEST_ASSERT(HAL_GPIO_Set(HAL_GPIO_PIN_LED));
+    TEST_ASSERT(MOCK_P0 == TEST_LED_MASK);
+    TEST_ASSERT(HAL_GPIO_Toggle(HAL_GPIO_PIN_LED));
+    TEST_ASSERT(MOCK_P0 == 0U);
+    HAL_GPIO_TOGGLE_FAST(HAL_GPIO_PIN_LED);
+    TEST_ASSERT(MOCK_P0 == TEST_LED_MASK);
+    TEST_ASSERT(HAL_GPIO_Clear(HAL_GPIO_PIN_LED));
+    TEST_ASSERT(MOCK_P0 == 0U);
+    TEST_ASSERT(HAL_GPIO_Toggle(HAL_GPIO_PIN_COUNT) == false);
+}
+
+static void test_claim_and_restore_masked_bits(void)
+{
+    test_setup();
+    static volatile uint8_t mode_ctl = 0xFFU;
+    const hal_gpio_port_pins_t pins = { &MOCK_P0, &MOCK_PM0, NULL, &mode_ctl, TEST_LED_MASK };
+    hal_gpio_port_snapshot_t snapshot;
+    const uint8_t pm0_before = MOCK_PM0;
+
+    MOCK_P0 = TEST_LED_MASK;
+    HAL_GPIO_ClaimPins(&pins, &snapshot);
+    TEST_ASSERT(MOCK_P0 == 0U);
+    TEST_ASSERT(MOCK_PM0 == (uint8_t)(pm0_before | TEST_LED_MASK));
+    TEST_ASSERT(mode_ctl == (uint8_t)(~TEST_LED_MASK));
+    TEST_ASSERT(MOCK_PU0 == TEST_BUTTON_MASK);
+
+    /* Other pins of the port change while the pins are claimed */
+    MOCK_P0 |= TEST_DOOR_MASK;
+    mode_ctl &= (uint8_t)(~TEST_BUTTON_MASK);
+
+    HAL_GPIO_RestorePins(&pins, &snapshot);
+    TEST_ASSERT(MOCK_P0 == (uint8_t)(TEST_LED_MASK | TEST_DOOR_MASK));
+    TEST_ASSERT(MOCK_PM0 == pm0_before);
+    TEST_ASSERT(mode_ctl == (uint8_t)(~TEST_BUTTON_MASK));
+}
+
+static void test_group_snapshot_restore(void)
+{
+    test_setup();
+    const hal_gpio_group_t group = HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_LED) | HAL_GPIO_GROUP_PIN(HAL_GPIO_PIN_SENSOR);
+    hal_gpio_group_snapshot_t snapshot;
+
+    TEST_ASSERT(HAL_GPIO_SnapshotGroup(group, &snapshot));
+    TEST_ASSERT(snapshot.count == 2U);
+
+    TEST_ASSERT(HAL_GPIO_SetMode(HAL_GPIO_PIN_SENSOR, HAL_GPIO_MODE_OUTPUT));
+    TEST_ASSERT(HAL_GPIO_SetMode(HAL_GPIO_PIN_LED, HAL_GPIO_MODE_INPUT_PULLUP));
+    TEST_ASSERT(HAL_GPIO_SetMode(HAL_GPIO_PIN_DOOR, HAL_GPIO_MODE_OUTPUT));
+    TEST_ASSERT(HAL_GPIO_Write(HAL_GPIO_PIN_SENSOR, HAL_GPIO_LEVEL_HIGH));
+
+    HAL_GPIO_RestoreGroup(&snapshot);
+    TEST_ASSERT((MOCK_PM1 & TEST_SENSOR_MASK) == TEST_SENSOR_MASK);
+    TEST_ASSERT((MOCK_P1 & TEST_SENSOR_MASK) == 0U);
+    TEST_ASSERT((MOCK_PM0 & TEST_LED_MASK) == 0U);
+    TEST_ASSERT(MOCK_PU0 == TEST_BUTTON_MASK);
+    /* Outside the group: kept as changed */
+    TEST_ASSERT((MOCK_PM0 & TEST_DOOR_MASK) == 0U);
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "init_applies_table_defaults", test_init_applies_table_defaults },
+    { "group_write_and_read", test_group_write_and_read },
+    { "toggle_flips_latch", test_toggle_flips_latch },
+    { "claim_and_restore_masked_bits", test_claim_and_restore_masked_bits },
+    { "group_snapshot_restore", test_group_snapshot_restore }
+};
+
+int main(void)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+/*
+ * Bus health monitor against the IICA0 configuration mock.
+ *
+ *   cc -std=c99 -Wall -Wextra -Iinclude -Itests/mocks \
+ *       tests/hal_i2c_bus_monitor_test.c tests/mocks/mock_r_config_iica0.c \
+ *       tests/mocks/mock_hal_scheduler.c app/hal_i2c_slave.c app/hal_i2c_bus_monitor.c
+ */
+#include "hal_i2c_bus_monitor.h"
+#include "mock_hal_scheduler.h"
+#include "mock_r_config_iica0.h"
+#include "r_config_iica0.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_LINES_IDLE       ((uint8_t)(R_IICA0_LINE_SDA | R_IICA0_LINE_SCL))
+#define TEST_LINES_SDA_LOW    ((uint8_t)R_IICA0_LINE_SCL)
+#define TEST_LINES_SCL_LOW    ((uint8_t)R_IICA0_LINE_SDA)
+
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+static hal_i2c_error_context_t g_last_error;
+
+static void test_error_callback(const hal_i2c_error_context_t *context)
+{
+    g_last_error = *context;
+}
+
+/* Raise the error in the slave ISR path, then hand it over as the app does */
+static void test_report(uint8_t hw_status)
+{
+    HAL_I2C_S_OnHardwareError(hw_status);
+    HAL_I2C_BUS_ReportFault(g_last_error.code, g_last_error.event_id);
+}
+
+static void test_setup(void)
+{
+    MOCK_R_Config_IICA0_Reset();
+    MOCK_HAL_SCHED_Reset();
+    MOCK_HAL_SCHED_SetUptime(UINT32_C(5000));
+    HAL_I2C_S_Init(test_error_callback);
+    HAL_I2C_BUS_Init();
+    MOCK_R_Config_IICA0_Reset();
+}
+
+static hal_i2c_bus_stats_t test_stats(void)
+{
+    hal_i2c_bus_stats_t stats;
+
+    HAL_I2C_BUS_GetStats(&stats);
+
+    return stats;
+}
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static void test_classify_from_line_levels(void)
+{
+    test_setup();
+    TEST_ASSERT(HAL_I2C_BUS_Classify() == HAL_I2C_BUS_FAULT_NONE);
+    MOCK_R_Config_IICA0_SetBusLines(TEST_LINES_SDA_LOW);
+    TEST_ASSERT(HAL_I2C_BUS_Classify() == HAL_I2C_BUS_FAULT_SDA_STUCK);
+    MOCK_R_Config_IICA0_SetBusLines(TEST_LINES_SCL_LOW);
+    TEST_ASSERT(HAL_I2C_BUS_Classify() == HAL_I2C_BUS_FAULT_SCL_STUCK);
+    MOCK_R_Config_IICA0_SetBusLines(0U);
+    TEST_ASSERT(HAL_I2C_BUS_Classify() == HAL_I2C_BUS_FAULT_SCL_STUCK);
+}
+
+static void test_glitch_only_rearms(void)
+{
+    test_setup();
+    test_report(R_IICA0_STATUS_BUS_ERROR);
+
+    const mock_r_config_iica0_state_t *state = MOCK_R_Config_IICA0_GetState();
+    const hal_i2c_bus_stats_t stats = test_stats();
+    hal_i2c_recovery_stats_t recovery;
+
+    /* The ISR already re-armed reception for this event */
+    HAL_I2C_S_GetRecoveryStats(&recovery);
+    TEST_ASSERT(state->create_calls == 0U);
+    TEST_ASSERT(state->slave_receive_start_calls == 1U);
+    TEST_ASSERT(recovery.coalesced == 1U);
+    TEST_ASSERT(state->reset_bus_lines_calls == 0U);
+    TEST_ASSERT(state->reset_peripheral_calls == 0U);
+    TEST_ASSERT(stats.last_fault == HAL_I2C_BUS_FAULT_GLITCH);
+    TEST_ASSERT(stats.last_action == HAL_I2C_BUS_ACTION_REARM);
+    TEST_ASSERT(stats.backoff_ms == HAL_I2C_BUS_BACKOFF_MIN_MS);
+    TEST_ASSERT(stats.lines_idle == true);
+    TEST_ASSERT(stats.last_recovery_us > 0U);
+}
+
+static void test_stuck_lines_pick_stronger_recovery(void)
+{
+    test_setup();
+    MOCK_R_Config_IICA0_SetBusLines(TEST_LINES_SDA_LOW);
+    test_report(R_IICA0_STATUS_LINE_STUCK);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->reset_bus_lines_calls == 1U);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->reset_peripheral_calls == 0U);
+    TEST_ASSERT(test_stats().last_action == HAL_I2C_BUS_ACTION_PULSE);
+
+    test_setup();
+    MOCK_R_Config_IICA0_SetBusLines(TEST_LINES_SCL_LOW);
+    test_report(R_IICA0_STATUS_LINE_STUCK);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->reset_peripheral_calls == 1U);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->reset_bus_lines_calls == 1U);
+    TEST_ASSERT(test_stats().last_action == HAL_I2C_BUS_ACTION_RESET);
+    TEST_ASSERT(test_stats().lines_idle == false);
+}
+
+static void test_fault_burst_is_coalesced_and_escalates(void)
+{
+    test_setup();
+    test_report(R_IICA0_STATUS_BUS_ERROR);
+
+    /* Within the 10 ms hold-off: counted, nothing re-created */
+    for (uint8_t burst = 0U; burst < 5U; burst++)
+    {
+        MOCK_HAL_SCHED_Advance(1U);
+        test_report(R_IICA0_STATUS_BUS_ERROR);
+    }
+    HAL_I2C_BUS_Task();
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->create_calls == 0U);
+    TEST_ASSERT(test_stats().deferred == 5U);
+
+    /* One recovery for the burst, a level up, with a doubled hold-off */
+    MOCK_HAL_SCHED_Advance(5U);
+    HAL_I2C_BUS_Task();
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->create_calls == 1U);
+    TEST_ASSERT(test_stats().last_action == HAL_I2C_BUS_ACTION_PULSE);
+    TEST_ASSERT(test_stats().backoff_ms == (2U * HAL_I2C_BUS_BACKOFF_MIN_MS));
+
+    HAL_I2C_BUS_Task();
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->create_calls == 1U);
+
+    MOCK_HAL_SCHED_Advance(1U);
+    test_report(R_IICA0_STATUS_BUS_ERROR);
+    MOCK_HAL_SCHED_Advance(2U * HAL_I2C_BUS_BACKOFF_MIN_MS);
+    HAL_I2C_BUS_Task();
+    TEST_ASSERT(test_stats().last_action == HAL_I2C_BUS_ACTION_RESET);
+    TEST_ASSERT(test_stats().backoff_ms == (4U * HAL_I2C_BUS_BACKOFF_MIN_MS));
+    TEST_ASSERT(test_stats().faults == 7U);
+}
+
+static void test_quiet_period_starts_over(void)
+{
+    test_setup();
+    test_report(R_IICA0_STATUS_BUS_ERROR);
+    MOCK_HAL_SCHED_Advance(HAL_I2C_BUS_BACKOFF_MIN_MS);
+    test_report(R_IICA0_STATUS_BUS_ERROR);
+    TEST_ASSERT(test_stats().last_action == HAL_I2C_BUS_ACTION_PULSE);
+
+    MOCK_HAL_SCHED_Advance(HAL_I2C_BUS_HEALTHY_MS);
+    test_report(R_IICA0_STATUS_BUS_ERROR);
+    TEST_ASSERT(test_stats().last_action == HAL_I2C_BUS_ACTION_REARM);
+    TEST_ASSERT(test_stats().backoff_ms == HAL_I2C_BUS_BACKOFF_MIN_MS);
+}
+
+static void test_stuck_bus_retried_with_growing_backoff(void)
+{
+    test_setup();
+    MOCK_R_Config_IICA0_SetBusLines(TEST_LINES_SCL_LOW);
+    test_report(R_IICA0_STATUS_LINE_STUCK);
+
+    uint32_t elapsed_ms = 0U;
+
+    /* About one reset per doubling backoff, not one per task period */
+    while (elapsed_ms < 1000U)
+    {
+        MOCK_HAL_SCHED_Advance(5U);
+        elapsed_ms += 5U;
+        HAL_I2C_BUS_Task();
+    }
+    TEST_ASSERT(test_stats().actions[HAL_I2C_BUS_ACTION_RESET] == 7U);
+    TEST_ASSERT(test_stats().backoff_ms == 640U);
+
+    MOCK_R_Config_IICA0_SetBusLines(TEST_LINES_IDLE);
+    MOCK_HAL_SCHED_Advance(640U);
+    HAL_I2C_BUS_Task();
+    TEST_ASSERT(test_stats().lines_idle == true);
+    TEST_ASSERT(test_stats().actions[HAL_I2C_BUS_ACTION_RESET] == 8U);
+
+    MOCK_HAL_SCHED_Advance(HAL_I2C_BUS_BACKOFF_MAX_MS);
+    HAL_I2C_BUS_Task();
+    TEST_ASSERT(test_stats().actions[HAL_I2C_BUS_ACTION_RESET] == 8U);
+}
+
+static void test_briefly_low_line_does_not_escalate(void)
+{
+    /* Traffic on a healthy bus: each line low at the first samples, then high */
+    static const uint8_t busy_bus[] = { TEST_LINES_SCL_LOW, 0U, TEST_LINES_SDA_LOW };
+
+    test_setup();
+    MOCK_R_Config_IICA0_SetBusLineSequence(busy_bus, (uint8_t)sizeof busy_bus);
+    TEST_ASSERT(HAL_I2C_BUS_Classify() == HAL_I2C_BUS_FAULT_NONE);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->sample_bus_lines_calls == 3U);
+
+    MOCK_R_Config_IICA0_SetBusLineSequence(busy_bus, (uint8_t)sizeof busy_bus);
+    test_report(R_IICA0_STATUS_BUS_ERROR);
+    TEST_ASSERT(test_stats().last_fault == HAL_I2C_BUS_FAULT_GLITCH);
+    TEST_ASSERT(test_stats().last_action == HAL_I2C_BUS_ACTION_REARM);
+    TEST_ASSERT(test_stats().lines_idle == true);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->reset_peripheral_calls == 0U);
+
+    /* Nothing left for the task to retry */
+    MOCK_HAL_SCHED_Advance(HAL_I2C_BUS_BACKOFF_MAX_MS);
+    HAL_I2C_BUS_Task();
+    TEST_ASSERT(test_stats().actions[HAL_I2C_BUS_ACTION_REARM] == 1U);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->reset_bus_lines_calls == 0U);
+
+    /* Low for the whole window: stuck */
+    MOCK_R_Config_IICA0_SetBusLines(TEST_LINES_SCL_LOW);
+    TEST_ASSERT(HAL_I2C_BUS_Classify() == HAL_I2C_BUS_FAULT_SCL_STUCK);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->sample_bus_lines_calls >= (5U + HAL_I2C_BUS_STUCK_SAMPLES));
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "classify_from_line_levels", test_classify_from_line_levels },
+    { "glitch_only_rearms", test_glitch_only_rearms },
+    { "stuck_lines_pick_stronger_recovery", test_stuck_lines_pick_stronger_recovery },
+    { "fault_burst_is_coalesced_and_escalates", test_fault_burst_is_coalesced_and_escalates },
+    { "quiet_period_starts_over", test_quiet_period_starts_over },
+    { "stuck_bus_retried_with_growing_backoff", test_stuck_bus_retried_with_growing_backoff },
+    { "briefly_low_line_does_not_escalate", test_briefly_low_line_does_not_escalate }
+};
+
+int main(void)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
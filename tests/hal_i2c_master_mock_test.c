@@ -0,0 +1,441 @@
+/*
+ * IICA1 master backend against the register-level model in mocks/mock_iica1.c.
+ *
+ *   cc -std=c99 -Wall -Wextra -DHAL_I2C_M_BACKEND=1U -Iinclude -Itests/mocks \
+ *       tests/hal_i2c_master_mock_test.c tests/mocks/mock_iica1.c \
+ *       tests/mocks/mock_hal_scheduler.c app/hal_i2c_master.c app/hal_i2c_master_iica.c
+ */
+#include "hal_i2c_master.h"
+#include "mock_hal_scheduler.h"
+#include "mock_iica1.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_DEVICE_ADDRESS7  (0x50U)
+#define TEST_MEMORY_SIZE      (256U)
+
+static uint8_t g_device_memory[TEST_MEMORY_SIZE];
+static uint32_t g_callback_count = 0U;
+static bool g_callback_success = false;
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+
+static void test_completion_callback(bool success, void *context)
+{
+    (void)context;
+    g_callback_count++;
+    g_callback_success = success;
+}
+
+static void test_setup(void)
+{
+    memset(g_device_memory, 0, sizeof g_device_memory);
+    g_callback_count = 0U;
+    g_callback_success = false;
+    MOCK_HAL_SCHED_Reset();
+    MOCK_IICA1_Reset();
+    MOCK_IICA1_SetInterruptHandler(HAL_I2C_M_OnInterrupt);
+    MOCK_IICA1_AttachDevice(TEST_DEVICE_ADDRESS7, g_device_memory, (uint16_t)sizeof g_device_memory);
+    HAL_I2C_M_Init();
+}
+
+static uint32_t run_bus_until_idle(void)
+{
+    uint32_t events = 0U;
+
+    while (MOCK_IICA1_Service())
+    {
+        events++;
+    }
+
+    return events;
+}
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static void test_init_configures_peripheral(void)
+{
+    test_setup();
+    TEST_ASSERT((MOCK_IICA1_Peek(MOCK_IICA1_REG_IICCTL0) & 0x80U) != 0U);
+    TEST_ASSERT((MOCK_IICA1_Peek(MOCK_IICA1_REG_IICCTL0) & 0x08U) != 0U);
+    TEST_ASSERT(MOCK_IICA1_Peek(MOCK_IICA1_REG_IICWL) != 0U);
+    TEST_ASSERT(MOCK_IICA1_Peek(MOCK_IICA1_REG_IICWH) != 0U);
+    TEST_ASSERT(IICAMK1 == 0U);
+    TEST_ASSERT(HAL_I2C_M_IsBusy() == false);
+}
+
+static void test_blocking_write_reaches_device(void)
+{
+    test_setup();
+    const uint8_t payload[] = { 0x10U, 0xDEU, 0xADU, 0xBEU };
+
+    TEST_ASSERT(HAL_I2C_M_Write(TEST_DEVICE_ADDRESS7, payload, (uint16_t)sizeof payload) == true);
+
+    const mock_iica1_state_t *state = MOCK_IICA1_GetState();
+    TEST_ASSERT(state->starts == 1U);
+    TEST_ASSERT(state->stops == 1U);
+    TEST_ASSERT(state->bytes_written == 4U);
+    TEST_ASSERT(g_device_memory[0x10] == 0xDEU);
+    TEST_ASSERT(g_device_memory[0x11] == 0xADU);
+    TEST_ASSERT(g_device_memory[0x12] == 0xBEU);
+    TEST_ASSERT(HAL_I2C_M_IsBusy() == false);
+}
+
+static void test_write_read_uses_repeated_start(void)
+{
+    test_setup();
+    g_device_memory[0x20] = 0x11U;
+    g_device_memory[0x21] = 0x22U;
+    g_device_memory[0x22] = 0x33U;
+    const uint8_t reg = 0x20U;
+    uint8_t rx[3] = {0};
+
+    TEST_ASSERT(HAL_I2C_M_WriteRead(TEST_DEVICE_ADDRESS7, &reg, 1U, rx, (uint16_t)sizeof rx) == true);
+    TEST_ASSERT(rx[0] == 0x11U);
+    TEST_ASSERT(rx[1] == 0x22U);
+    TEST_ASSERT(rx[2] == 0x33U);
+
+    const mock_iica1_state_t *state = MOCK_IICA1_GetState();
+    TEST_ASSERT(state->starts == 2U);
+    TEST_ASSERT(state->stops == 1U);
+    TEST_ASSERT(state->bytes_read == 3U);
+    TEST_ASSERT(state->master_nacks == 1U);
+}
+
+static void test_address_nack_fails_with_stop(void)
+{
+    test_setup();
+    const uint8_t payload[] = { 0x00U, 0x01U };
+
+    TEST_ASSERT(HAL_I2C_M_Write(0x51U, payload, (uint16_t)sizeof payload) == false);
+    TEST_ASSERT(HAL_I2C_M_Probe(0x51U) == false);
+    TEST_ASSERT(HAL_I2C_M_Probe(TEST_DEVICE_ADDRESS7) == true);
+
+    const mock_iica1_state_t *state = MOCK_IICA1_GetState();
+    TEST_ASSERT(state->address_nacks == 2U);
+    TEST_ASSERT(state->stops == 3U);
+    TEST_ASSERT(state->bytes_written == 0U);
+}
+
+static void test_async_write_returns_before_transfer(void)
+{
+    test_setup();
+    const uint8_t payload[] = { 0x05U, 0xA5U, 0x5AU };
+
+    TEST_ASSERT(HAL_I2C_M_WriteAsync(TEST_DEVICE_ADDRESS7, payload, (uint16_t)sizeof payload,
+                                     test_completion_callback, NULL) == true);
+    TEST_ASSERT(HAL_I2C_M_IsBusy() == true);
+    TEST_ASSERT(g_callback_count == 0U);
+    TEST_ASSERT(MOCK_IICA1_GetState()->bytes_written == 0U);
+
+    TEST_ASSERT(HAL_I2C_M_WriteAsync(TEST_DEVICE_ADDRESS7, payload, (uint16_t)sizeof payload,
+                                     test_completion_callback, NULL) == false);
+
+    const uint32_t events = run_bus_until_idle();
+    TEST_ASSERT(events == 4U);
+    TEST_ASSERT(g_callback_count == 1U);
+    TEST_ASSERT(g_callback_success == true);
+    TEST_ASSERT(HAL_I2C_M_IsBusy() == false);
+    TEST_ASSERT(g_device_memory[0x05] == 0xA5U);
+    TEST_ASSERT(g_device_memory[0x06] == 0x5AU);
+}
+
+static void test_async_read_reports_completion(void)
+{
+    test_setup();
+    uint8_t rx[2] = {0};
+
+    g_device_memory[0] = 0x77U;
+    g_device_memory[1] = 0x88U;
+    TEST_ASSERT(HAL_I2C_M_ReadAsync(TEST_DEVICE_ADDRESS7, rx, (uint16_t)sizeof rx,
+                                    test_completion_callback, NULL) == true);
+    (void)run_bus_until_idle();
+    TEST_ASSERT(g_callback_count == 1U);
+    TEST_ASSERT(g_callback_success == true);
+    TEST_ASSERT(rx[0] == 0x77U);
+    TEST_ASSERT(rx[1] == 0x88U);
+}
+
+static uint8_t g_completion_order[4];
+static uint8_t g_completion_count = 0U;
+
+static void test_queue_callback(bool success, void *context)
+{
+    const uint8_t *tag = (const uint8_t *)context;
+
+    if (success && (g_completion_count < sizeof g_completion_order))
+    {
+        g_completion_order[g_completion_count] = *tag;
+        g_completion_count++;
+    }
+}
+
+static void test_queue_chains_from_interrupt(void)
+{
+    test_setup();
+    g_completion_count = 0U;
+    g_device_memory[0x30] = 0x42U;
+
+    static const uint8_t tags[3] = { 1U, 2U, 3U };
+    const uint8_t write_a[] = { 0x08U, 0xA1U };
+    const uint8_t write_b[] = { 0x09U, 0xB2U };
+    const uint8_t reg = 0x30U;
+    uint8_t rx = 0U;
+
+    const hal_i2c_m_txn_t txn_a = { TEST_DEVICE_ADDRESS7, write_a, 2U, NULL, 0U, (void *)&tags[0] };
+    const hal_i2c_m_txn_t txn_b = { TEST_DEVICE_ADDRESS7, write_b, 2U, NULL, 0U, (void *)&tags[1] };
+    const hal_i2c_m_txn_t txn_c = { TEST_DEVICE_ADDRESS7, &reg, 1U, &rx, 1U, (void *)&tags[2] };
+
+    TEST_ASSERT(HAL_I2C_M_Submit(&txn_a, test_queue_callback) == true);
+    TEST_ASSERT(HAL_I2C_M_Submit(&txn_b, test_queue_callback) == true);
+    TEST_ASSERT(HAL_I2C_M_Submit(&txn_c, test_queue_callback) == true);
+    TEST_ASSERT(HAL_I2C_M_GetPendingCount() == 3U);
+    TEST_ASSERT(MOCK_IICA1_GetState()->starts == 1U);
+
+    (void)run_bus_until_idle();
+
+    TEST_ASSERT(HAL_I2C_M_GetPendingCount() == 0U);
+    TEST_ASSERT(g_completion_count == 3U);
+    TEST_ASSERT(g_completion_order[0] == 1U);
+    TEST_ASSERT(g_completion_order[1] == 2U);
+    TEST_ASSERT(g_completion_order[2] == 3U);
+    TEST_ASSERT(g_device_memory[0x08] == 0xA1U);
+    TEST_ASSERT(g_device_memory[0x09] == 0xB2U);
+    TEST_ASSERT(rx == 0x42U);
+}
+
+static void test_queue_rejects_when_full(void)
+{
+    test_setup();
+    const uint8_t payload[] = { 0x00U, 0x00U };
+    const hal_i2c_m_txn_t txn = { TEST_DEVICE_ADDRESS7, payload, 2U, NULL, 0U, NULL };
+
+    for (uint8_t index = 0U; index < HAL_I2C_M_QUEUE_DEPTH; index++)
+    {
+        TEST_ASSERT(HAL_I2C_M_Submit(&txn, NULL) == true);
+    }
+    TEST_ASSERT(HAL_I2C_M_Submit(&txn, NULL) == false);
+
+    (void)run_bus_until_idle();
+    TEST_ASSERT(HAL_I2C_M_GetPendingCount() == 0U);
+    TEST_ASSERT(HAL_I2C_M_Submit(&txn, NULL) == true);
+    (void)run_bus_until_idle();
+}
+
+static void test_bus_speed_reprograms_width_registers(void)
+{
+    test_setup();
+    const uint8_t standard_low = MOCK_IICA1_Peek(MOCK_IICA1_REG_IICWL);
+
+    TEST_ASSERT(HAL_I2C_M_GetBusSpeed() == HAL_I2C_M_SPEED_STANDARD);
+    TEST_ASSERT((MOCK_IICA1_Peek(MOCK_IICA1_REG_IICCTL1) & 0x08U) == 0U);
+
+    TEST_ASSERT(HAL_I2C_M_SetBusSpeed(HAL_I2C_M_SPEED_FAST) == true);
+    TEST_ASSERT(HAL_I2C_M_GetBusSpeed() == HAL_I2C_M_SPEED_FAST);
+    TEST_ASSERT((MOCK_IICA1_Peek(MOCK_IICA1_REG_IICCTL1) & 0x08U) != 0U);
+    TEST_ASSERT(MOCK_IICA1_Peek(MOCK_IICA1_REG_IICWL) < standard_low);
+    TEST_ASSERT(HAL_I2C_M_SetBusSpeed(HAL_I2C_M_SPEED_COUNT) == false);
+
+    const uint8_t payload[] = { 0x00U, 0x01U };
+    TEST_ASSERT(HAL_I2C_M_WriteAsync(TEST_DEVICE_ADDRESS7, payload, 2U, NULL, NULL) == true);
+    TEST_ASSERT(HAL_I2C_M_SetBusSpeed(HAL_I2C_M_SPEED_FAST_PLUS) == false);
+    (void)run_bus_until_idle();
+    TEST_ASSERT(HAL_I2C_M_SetBusSpeed(HAL_I2C_M_SPEED_FAST_PLUS) == true);
+    TEST_ASSERT(HAL_I2C_M_Write(TEST_DEVICE_ADDRESS7, payload, 2U) == true);
+}
+
+typedef struct
+{
+    uint32_t sum;
+    uint16_t chunks;
+    uint16_t bytes;
+    uint16_t stop_after_chunks;
+} test_stream_sink_t;
+
+static bool test_stream_consumer(const uint8_t *chunk, uint16_t length, void *context)
+{
+    test_stream_sink_t *sink = (test_stream_sink_t *)context;
+
+    for (uint16_t index = 0U; index < length; index++)
+    {
+        sink->sum += chunk[index];
+    }
+    sink->bytes = (uint16_t)(sink->bytes + length);
+    sink->chunks++;
+
+    return (sink->stop_after_chunks == 0U) || (sink->chunks < sink->stop_after_chunks);
+}
+
+static void test_stream_read_uses_one_transaction(void)
+{
+    test_setup();
+    uint32_t expected = 0U;
+
+    for (uint16_t index = 0U; index < TEST_MEMORY_SIZE; index++)
+    {
+        g_device_memory[index] = (uint8_t)(index * 3U);
+        if ((index >= 4U) && (index < 44U))
+        {
+            expected += g_device_memory[index];
+        }
+    }
+
+    const uint8_t reg = 0x04U;
+    uint8_t chunk[8];
+    test_stream_sink_t sink = { 0U, 0U, 0U, 0U };
+
+    TEST_ASSERT(HAL_I2C_M_WriteReadStream(TEST_DEVICE_ADDRESS7, &reg, 1U, 40U, chunk, (uint16_t)sizeof chunk,
+                                          test_stream_consumer, &sink) == true);
+    TEST_ASSERT(sink.bytes == 40U);
+    TEST_ASSERT(sink.chunks == 5U);
+    TEST_ASSERT(sink.sum == expected);
+
+    const mock_iica1_state_t *state = MOCK_IICA1_GetState();
+    TEST_ASSERT(state->starts == 2U);
+    TEST_ASSERT(state->stops == 1U);
+    TEST_ASSERT(state->master_nacks == 1U);
+}
+
+static void test_stream_read_stops_when_consumer_declines(void)
+{
+    test_setup();
+    const uint8_t reg = 0x00U;
+    uint8_t chunk[4];
+    test_stream_sink_t sink = { 0U, 0U, 0U, 2U };
+
+    TEST_ASSERT(HAL_I2C_M_WriteReadStream(TEST_DEVICE_ADDRESS7, &reg, 1U, 32U, chunk, (uint16_t)sizeof chunk,
+                                          test_stream_consumer, &sink) == false);
+    TEST_ASSERT(sink.chunks == 2U);
+    TEST_ASSERT(MOCK_IICA1_GetState()->bytes_read == 9U);
+    TEST_ASSERT(MOCK_IICA1_GetState()->stops == 1U);
+    TEST_ASSERT(HAL_I2C_M_IsBusy() == false);
+}
+
+static void test_eeprom_write_splits_at_device_pages(void)
+{
+    test_setup();
+    static const hal_i2c_m_eeprom_t device = HAL_I2C_M_EEPROM_PART_24C02(TEST_DEVICE_ADDRESS7);
+    uint8_t pattern[20];
+    uint8_t readback[20] = {0};
+
+    for (uint8_t index = 0U; index < sizeof pattern; index++)
+    {
+        pattern[index] = (uint8_t)(0x40U + index);
+    }
+
+    TEST_ASSERT(HAL_I2C_M_EEPROM_Write(&device, 0x06U, pattern, (uint16_t)sizeof pattern) == true);
+    TEST_ASSERT(g_device_memory[0x05] == 0x00U);
+    TEST_ASSERT(g_device_memory[0x06] == 0x40U);
+    TEST_ASSERT(g_device_memory[0x19] == 0x53U);
+    TEST_ASSERT(g_device_memory[0x1A] == 0x00U);
+    /* 2 + 8 + 8 + 2 bytes: four page programs, one address byte each */
+    TEST_ASSERT(MOCK_IICA1_GetState()->bytes_written == 24U);
+    TEST_ASSERT(HAL_I2C_M_EEPROM_GetLastWriteTimeUs() >= device.write_cycle_us);
+    TEST_ASSERT(HAL_I2C_M_GetBusSpeed() == HAL_I2C_M_SPEED_STANDARD);
+
+    TEST_ASSERT(HAL_I2C_M_EEPROM_Read(&device, 0x06U, readback, (uint16_t)sizeof readback) == true);
+    TEST_ASSERT(memcmp(pattern, readback, sizeof pattern) == 0);
+    TEST_ASSERT(HAL_I2C_M_EEPROM_Read(&device, 0xF0U, readback, (uint16_t)sizeof readback) == false);
+}
+
+/* 100 kHz: nine clocks per byte, so eleven bytes take about a millisecond */
+#define TEST_BYTES_PER_MS  (11U)
+
+static uint32_t g_bus_bytes = 0U;
+
+static void test_bus_clock(void)
+{
+    g_bus_bytes++;
+    if ((g_bus_bytes % TEST_BYTES_PER_MS) == 0U)
+    {
+        MOCK_HAL_SCHED_Advance(1U);
+    }
+}
+
+static void test_long_blocking_read_outlasts_timeout(void)
+{
+    test_setup();
+    static uint8_t buffer[600];
+
+    for (uint16_t index = 0U; index < TEST_MEMORY_SIZE; index++)
+    {
+        g_device_memory[index] = (uint8_t)(index ^ 0x5AU);
+    }
+
+    g_bus_bytes = 0U;
+    MOCK_IICA1_SetServiceHook(test_bus_clock);
+
+    /* About 55 ms on the bus, twice the stall limit of the blocking wait */
+    TEST_ASSERT(HAL_I2C_M_Read(TEST_DEVICE_ADDRESS7, buffer, (uint16_t)sizeof buffer) == true);
+    TEST_ASSERT(MOCK_IICA1_GetState()->bytes_read == sizeof buffer);
+    TEST_ASSERT(MOCK_IICA1_GetState()->stops == 1U);
+    TEST_ASSERT(buffer[0] == 0x5AU);
+    TEST_ASSERT(buffer[sizeof buffer - 1U] == (uint8_t)(((sizeof buffer - 1U) % TEST_MEMORY_SIZE) ^ 0x5AU));
+    TEST_ASSERT(HAL_I2C_M_IsBusy() == false);
+
+    MOCK_IICA1_SetServiceHook(NULL);
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "init_configures_peripheral", test_init_configures_peripheral },
+    { "blocking_write_reaches_device", test_blocking_write_reaches_device },
+    { "write_read_uses_repeated_start", test_write_read_uses_repeated_start },
+    { "address_nack_fails_with_stop", test_address_nack_fails_with_stop },
+    { "async_write_returns_before_transfer", test_async_write_returns_before_transfer },
+    { "async_read_reports_completion", test_async_read_reports_completion },
+    { "queue_chains_from_interrupt", test_queue_chains_from_interrupt },
+    { "queue_rejects_when_full", test_queue_rejects_when_full },
+    { "bus_speed_reprograms_width_registers", test_bus_speed_reprograms_width_registers },
+    { "stream_read_uses_one_transaction", test_stream_read_uses_one_transaction },
+    { "stream_read_stops_when_consumer_declines", test_stream_read_stops_when_consumer_declines },
+    { "eeprom_write_splits_at_device_pages", test_eeprom_write_splits_at_device_pages },
+    { "long_blocking_read_outlasts_timeout", test_long_blocking_read_outlasts_timeout }
+};
+
+int main(void)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
@@ -128,7 +128,7 @@ static void test_slave_response_rejects_invalid_length(void)
     TEST_ASSERT(length == 0U);
 }
 
-static void test_overrun_on_long_message_triggers_reset(void)
+static void test_overrun_on_long_message_drops_frame_only(void)
 {
     test_setup();
     MOCK_HAL_SCHED_SetUptime(10U);
@@ -141,20 +141,26 @@ static void test_overrun_on_long_message_triggers_reset(void)
 
     const mock_r_config_iica0_state_t before = *MOCK_R_Config_IICA0_GetState();
     HAL_I2C_S_OnByteReceived(0xFFU);
+    HAL_I2C_S_OnByteReceived(0xFEU);
+    HAL_I2C_S_OnStopCondition(0x00U);
     const mock_r_config_iica0_state_t after = *MOCK_R_Config_IICA0_GetState();
 
-    TEST_ASSERT(after.stop_calls == (before.stop_calls + 1U));
-    TEST_ASSERT(after.create_calls == (before.create_calls + 1U));
-    TEST_ASSERT(after.start_calls == (before.start_calls + 1U));
-    TEST_ASSERT(after.slave_receive_start_calls == (before.slave_receive_start_calls + 1U));
+    /* The peripheral keeps running; only the frame is thrown away */
+    TEST_ASSERT(after.stop_calls == before.stop_calls);
+    TEST_ASSERT(after.create_calls == before.create_calls);
+    TEST_ASSERT(after.start_calls == before.start_calls);
+    TEST_ASSERT(after.slave_receive_start_calls == before.slave_receive_start_calls);
     TEST_ASSERT(g_recorded_error_count == 1U);
     TEST_ASSERT(g_recorded_errors[0].code == HAL_I2C_ERR_OVERRUN);
     TEST_ASSERT(g_recorded_errors[0].message_dropped == true);
+    TEST_ASSERT(g_recorded_errors[0].recovery == HAL_I2C_RECOVERY_LIGHT);
+
+    hal_i2c_message_t message;
+    TEST_ASSERT(HAL_I2C_S_PopMessage(&message) == false);
 }
 
-static void test_timeout_during_reception(void)
+static void test_stalled_frame(void)
 {
-    test_setup();
     HAL_I2C_S_OnStartCondition(0x00U);
     HAL_I2C_S_OnByteReceived(0x01U);
 
@@ -163,12 +169,45 @@ static void test_timeout_during_reception(void)
         MOCK_HAL_SCHED_Advance(1U);
         HAL_I2C_S_Tick1ms();
     }
+}
+
+static void test_timeout_during_reception(void)
+{
+    test_setup();
+    test_stalled_frame();
 
     TEST_ASSERT(g_recorded_error_count == 1U);
     TEST_ASSERT(g_recorded_errors[0].code == HAL_I2C_ERR_TIMEOUT);
     TEST_ASSERT(g_recorded_errors[0].message_dropped == true);
 }
 
+static void test_repeated_timeout_escalates(void)
+{
+    test_setup();
+    const mock_r_config_iica0_state_t before = *MOCK_R_Config_IICA0_GetState();
+
+    /* Re-arm reception first */
+    test_stalled_frame();
+    TEST_ASSERT(g_recorded_error_count == 1U);
+    TEST_ASSERT(g_recorded_errors[0].recovery == HAL_I2C_RECOVERY_MEDIUM);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->slave_receive_start_calls == (before.slave_receive_start_calls + 1U));
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->create_calls == before.create_calls);
+
+    /* Stalled again with no good frame in between: re-create the peripheral */
+    test_stalled_frame();
+    TEST_ASSERT(g_recorded_error_count == 2U);
+    TEST_ASSERT(g_recorded_errors[1].recovery == HAL_I2C_RECOVERY_FULL);
+    TEST_ASSERT(MOCK_R_Config_IICA0_GetState()->create_calls == (before.create_calls + 1U));
+
+    /* A good frame starts the ladder over */
+    HAL_I2C_S_OnStartCondition(0x00U);
+    HAL_I2C_S_OnByteReceived(0x02U);
+    HAL_I2C_S_OnStopCondition(0x00U);
+    test_stalled_frame();
+    TEST_ASSERT(g_recorded_error_count == 3U);
+    TEST_ASSERT(g_recorded_errors[2].recovery == HAL_I2C_RECOVERY_MEDIUM);
+}
+
 static void test_hardware_error_mapping(void)
 {
     test_setup();
@@ -189,6 +228,71 @@ static void test_hardware_error_mapping(void)
     TEST_ASSERT(g_recorded_errors[5].code == HAL_I2C_ERR_FRAME);
 }
 
+static void test_hardware_error_recovery_levels(void)
+{
+    test_setup();
+    hal_i2c_recovery_stats_t stats;
+    mock_r_config_iica0_state_t before = *MOCK_R_Config_IICA0_GetState();
+
+    /* A bus error re-arms reception without re-creating the peripheral */
+    HAL_I2C_S_OnHardwareError(R_IICA0_STATUS_BUS_ERROR);
+    const mock_r_config_iica0_state_t *state = MOCK_R_Config_IICA0_GetState();
+    TEST_ASSERT(state->create_calls == before.create_calls);
+    TEST_ASSERT(state->slave_receive_start_calls == (before.slave_receive_start_calls + 1U));
+    TEST_ASSERT(g_recorded_errors[0].recovery == HAL_I2C_RECOVERY_MEDIUM);
+
+    HAL_I2C_S_OnHardwareError(R_IICA0_STATUS_NACK);
+    TEST_ASSERT(state->slave_receive_start_calls == (before.slave_receive_start_calls + 1U));
+    TEST_ASSERT(g_recorded_errors[1].recovery == HAL_I2C_RECOVERY_LIGHT);
+
+    before = *state;
+    HAL_I2C_S_OnHardwareError(R_IICA0_STATUS_LINE_STUCK);
+    TEST_ASSERT(state->stop_calls == (before.stop_calls + 1U));
+    TEST_ASSERT(state->create_calls == (before.create_calls + 1U));
+    TEST_ASSERT(g_recorded_errors[2].recovery == HAL_I2C_RECOVERY_FULL);
+
+    /* Every error is its own event */
+    TEST_ASSERT(g_recorded_errors[1].event_id == (uint8_t)(g_recorded_errors[0].event_id + 1U));
+    TEST_ASSERT(g_recorded_errors[2].event_id == (uint8_t)(g_recorded_errors[1].event_id + 1U));
+
+    HAL_I2C_S_GetRecoveryStats(&stats);
+    TEST_ASSERT(stats.light == 1U);
+    TEST_ASSERT(stats.medium == 1U);
+    TEST_ASSERT(stats.full == 1U);
+}
+
+static void test_recover_event_is_coalesced(void)
+{
+    test_setup();
+    hal_i2c_recovery_stats_t stats;
+
+    HAL_I2C_S_OnHardwareError(R_IICA0_STATUS_BUS_ERROR);
+    const uint8_t event_id = g_recorded_errors[0].event_id;
+    const mock_r_config_iica0_state_t before = *MOCK_R_Config_IICA0_GetState();
+    const mock_r_config_iica0_state_t *state = MOCK_R_Config_IICA0_GetState();
+
+    /* The ISR already did this much for the event */
+    TEST_ASSERT(HAL_I2C_S_RecoverEvent(event_id, HAL_I2C_RECOVERY_LIGHT) == false);
+    TEST_ASSERT(HAL_I2C_S_RecoverEvent(event_id, HAL_I2C_RECOVERY_MEDIUM) == false);
+    TEST_ASSERT(state->slave_receive_start_calls == before.slave_receive_start_calls);
+    TEST_ASSERT(state->create_calls == before.create_calls);
+
+    /* Escalation runs once, then the event is covered */
+    TEST_ASSERT(HAL_I2C_S_RecoverEvent(event_id, HAL_I2C_RECOVERY_FULL) == true);
+    TEST_ASSERT(state->create_calls == (before.create_calls + 1U));
+    TEST_ASSERT(HAL_I2C_S_RecoverEvent(event_id, HAL_I2C_RECOVERY_FULL) == false);
+    TEST_ASSERT(state->create_calls == (before.create_calls + 1U));
+
+    /* A later error supersedes the request */
+    HAL_I2C_S_OnHardwareError(R_IICA0_STATUS_NACK);
+    TEST_ASSERT(HAL_I2C_S_RecoverEvent(event_id, HAL_I2C_RECOVERY_FULL) == false);
+    TEST_ASSERT(state->create_calls == (before.create_calls + 1U));
+
+    HAL_I2C_S_GetRecoveryStats(&stats);
+    TEST_ASSERT(stats.coalesced == 4U);
+    TEST_ASSERT(stats.full == 1U);
+}
+
 static void test_ring_buffer_overflow_reports_error(void)
 {
     test_setup();
@@ -232,9 +336,12 @@ static test_case_t g_tests[] = {
     { "message_buffering_and_pop", test_message_buffering_and_pop },
     { "slave_response_set_get_clear", test_slave_response_set_get_clear },
     { "slave_response_rejects_invalid_length", test_slave_response_rejects_invalid_length },
-    { "overrun_on_long_message_triggers_reset", test_overrun_on_long_message_triggers_reset },
+    { "overrun_on_long_message_drops_frame_only", test_overrun_on_long_message_drops_frame_only },
     { "timeout_during_reception", test_timeout_during_reception },
+    { "repeated_timeout_escalates", test_repeated_timeout_escalates },
     { "hardware_error_mapping", test_hardware_error_mapping },
+    { "hardware_error_recovery_levels", test_hardware_error_recovery_levels },
+    { "recover_event_is_coalesced", test_recover_event_is_coalesced },
     { "ring_buffer_overflow_reports_error", test_ring_buffer_overflow_reports_error }
 };
 
@@ -0,0 +1,435 @@
+/*
+ * Bit-banged bus timing on the virtual port in mocks/mock_port.c. Pass a
+ * directory as the first argument to keep a VCD of each test for GTKWave.
+ *
+ *   cc -std=c99 -Wall -Wextra -Itests/mocks -Iinclude \
+ *       tests/hal_i2c_port_timing_test.c tests/mocks/mock_port.c \
+ *       tests/mocks/mock_gpio_ports.c tests/mocks/mock_hal_scheduler.c \
+ *       app/hal_gpio.c app/hal_i2c_master.c app/r_config_iica0_user.c
+ */
+#include "hal_i2c_master.h"
+#include "hal_i2c_slave.h"
+#include "mock_port.h"
+#include "r_cg_macrodriver.h"
+#include "r_config_iica0.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_PINS_MASK  ((uint8_t)(MOCK_PORT_LINE_SDA | MOCK_PORT_LINE_SCL))
+
+/* Waveform measurements over the recorded log */
+typedef struct
+{
+    uint32_t rising;
+    uint32_t clocks;        /* rising edges followed by a falling one */
+    uint32_t starts;
+    uint32_t stops;
+    uint32_t data_changes_while_high;
+    uint32_t min_high_ns;   /* complete high pulses only */
+    uint32_t min_low_ns;
+    uint32_t min_setup_ns;  /* last SDA change to the next SCL rising edge */
+    uint32_t driven_high;   /* logged states with a bus pin output and latched high */
+} test_waveform_t;
+
+static const char *g_vcd_directory = NULL;
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+
+/* The IICA0 peripheral itself is not under test */
+void R_Config_IICA0_Stop(void) {}
+void R_Config_IICA0_Create(void) {}
+void R_Config_IICA0_Start(void) {}
+void R_Config_IICA0_SlaveReceiveStart(void) {}
+void HAL_I2C_S_OnStartCondition(uint8_t status_flags) { (void)status_flags; }
+void HAL_I2C_S_OnByteReceived(uint8_t data_byte) { (void)data_byte; }
+void HAL_I2C_S_OnStopCondition(uint8_t status_flags) { (void)status_flags; }
+void HAL_I2C_S_OnHardwareError(uint8_t status_flags) { (void)status_flags; }
+
+static void test_setup(void)
+{
+    MOCK_PORT_Reset();
+    HAL_I2C_M_Init();
+}
+
+static void test_measure(test_waveform_t *waveform)
+{
+    uint32_t count = 0U;
+    const mock_port_event_t *events = MOCK_PORT_GetEvents(&count);
+    uint32_t scl_rise_cycle = 0U;
+    uint32_t scl_fall_cycle = 0U;
+    uint32_t sda_change_cycle = 0U;
+    bool seen_rise = false;
+    bool seen_fall = false;
+
+    memset(waveform, 0, sizeof *waveform);
+    waveform->min_high_ns = UINT32_MAX;
+    waveform->min_low_ns = UINT32_MAX;
+    waveform->min_setup_ns = UINT32_MAX;
+
+    /* Open-drain lines are only ever released or pulled low, never driven high */
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        const uint8_t *regs = events[index].regs;
+
+        if (((uint8_t)(~regs[MOCK_PORT_REG_PM6] & regs[MOCK_PORT_REG_P6]) & TEST_PINS_MASK) != 0U)
+        {
+            waveform->driven_high++;
+        }
+    }
+
+    for (uint32_t index = 1U; index < count; index++)
+    {
+        const uint8_t before = events[index - 1U].lines;
+        const uint8_t after = events[index].lines;
+        const uint32_t cycle = events[index].cycle;
+        const bool scl_before = ((before & MOCK_PORT_LINE_SCL) != 0U);
+        const bool scl_after = ((after & MOCK_PORT_LINE_SCL) != 0U);
+
+        if (((before ^ after) & MOCK_PORT_LINE_SDA) != 0U)
+        {
+            sda_change_cycle = cycle;
+            if (scl_before && scl_after)
+            {
+                if ((after & MOCK_PORT_LINE_SDA) == 0U)
+                {
+                    waveform->starts++;
+                }
+                else
+                {
+                    waveform->stops++;
+                }
+            }
+            else if (!scl_before && scl_after)
+            {
+                waveform->data_changes_while_high++;
+            }
+            else
+            {
+                /* Changed while SCL is low, or together with its falling edge */
+            }
+        }
+
+        if (!scl_before && scl_after)
+        {
+            waveform->rising++;
+            scl_rise_cycle = cycle;
+            seen_rise = true;
+            if (seen_fall)
+            {
+                const uint32_t low_ns = MOCK_PORT_CyclesToNs(cycle - scl_fall_cycle);
+                const uint32_t setup_ns = MOCK_PORT_CyclesToNs(cycle - sda_change_cycle);
+
+                waveform->min_low_ns = (low_ns < waveform->min_low_ns) ? low_ns : waveform->min_low_ns;
+                waveform->min_setup_ns = (setup_ns < waveform->min_setup_ns) ? setup_ns : waveform->min_setup_ns;
+            }
+        }
+        else if (scl_before && !scl_after)
+        {
+            scl_fall_cycle = cycle;
+            seen_fall = true;
+            if (seen_rise)
+            {
+                const uint32_t high_ns = MOCK_PORT_CyclesToNs(cycle - scl_rise_cycle);
+
+                waveform->clocks++;
+                waveform->min_high_ns = (high_ns < waveform->min_high_ns) ? high_ns : waveform->min_high_ns;
+            }
+        }
+        else
+        {
+            /* No action required */
+        }
+    }
+}
+
+static void test_dump(const char *name)
+{
+    char path[256];
+
+    if (g_vcd_directory == NULL)
+    {
+        return;
+    }
+
+    (void)snprintf(path, sizeof path, "%s/%s.vcd", g_vcd_directory, name);
+    FILE *stream = fopen(path, "w");
+    if (stream != NULL)
+    {
+        (void)MOCK_PORT_WriteVcd(stream);
+        (void)fclose(stream);
+    }
+}
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static void test_standard_mode_probe_timing(void)
+{
+    test_setup();
+    test_waveform_t waveform;
+
+    /* Nobody answers: the address byte is NACKed but fully clocked */
+    TEST_ASSERT(HAL_I2C_M_Probe(0x50U) == false);
+    test_dump("probe_standard");
+    test_measure(&waveform);
+    TEST_ASSERT(waveform.driven_high == 0U);
+
+    /* Eight address bits and the ACK slot, then the rising edge of the STOP */
+    TEST_ASSERT(waveform.clocks == 9U);
+    TEST_ASSERT(waveform.rising == 10U);
+    TEST_ASSERT(waveform.min_high_ns >= 4000U);
+    TEST_ASSERT(waveform.min_low_ns >= 4700U);
+    TEST_ASSERT(waveform.min_setup_ns >= 250U);
+}
+
+static void test_fast_mode_probe_timing(void)
+{
+    test_setup();
+    test_waveform_t waveform;
+
+    TEST_ASSERT(HAL_I2C_M_SetBusSpeed(HAL_I2C_M_SPEED_FAST));
+    TEST_ASSERT(HAL_I2C_M_Probe(0x50U) == false);
+    test_dump("probe_fast");
+    test_measure(&waveform);
+    TEST_ASSERT(waveform.driven_high == 0U);
+
+    TEST_ASSERT(waveform.clocks == 9U);
+    TEST_ASSERT(waveform.min_high_ns >= 600U);
+    TEST_ASSERT(waveform.min_low_ns >= 1300U);
+    TEST_ASSERT(waveform.min_setup_ns >= 100U);
+    TEST_ASSERT(HAL_I2C_M_SetBusSpeed(HAL_I2C_M_SPEED_STANDARD));
+}
+
+static void test_data_changes_only_while_clock_low(void)
+{
+    test_setup();
+    test_waveform_t waveform;
+    const uint8_t data[2] = { 0xA5U, 0x3CU };
+
+    TEST_ASSERT(HAL_I2C_M_Write(0x50U, data, 2U) == false);
+    test_measure(&waveform);
+    TEST_ASSERT(waveform.driven_high == 0U);
+    TEST_ASSERT(waveform.starts == 1U);
+    TEST_ASSERT(waveform.stops == 1U);
+    TEST_ASSERT(waveform.data_changes_while_high == 0U);
+
+    /* Both lines end released and P6 is handed back as it was */
+    TEST_ASSERT(MOCK_PORT_Lines() == TEST_PINS_MASK);
+    TEST_ASSERT(PM6 == 0xFFU);
+    TEST_ASSERT(PU6 == 0x00U);
+}
+
+static void test_bus_recovery_stops_when_sda_released(void)
+{
+    test_setup();
+    test_waveform_t waveform;
+
+    P6 = 0xA4U;
+    PM6 = 0x57U;
+    PMC6 = 0x08U;
+    PU6 = 0x80U;
+
+    /* A slave stuck mid-byte lets go of SDA after three more clocks */
+    MOCK_PORT_HoldLow(MOCK_PORT_LINE_SDA, 3U);
+    R_Config_IICA0_ResetBusLines();
+    test_dump("recovery_three_clocks");
+    test_measure(&waveform);
+    TEST_ASSERT(waveform.driven_high == 0U);
+
+    TEST_ASSERT(waveform.clocks == 3U);
+    TEST_ASSERT(waveform.rising == 4U);
+    TEST_ASSERT(waveform.stops == 1U);
+    TEST_ASSERT(waveform.min_high_ns >= 4000U);
+    TEST_ASSERT(waveform.min_low_ns >= 4700U);
+    TEST_ASSERT(MOCK_PORT_Lines() == TEST_PINS_MASK);
+
+    TEST_ASSERT(P6 == 0xA4U);
+    TEST_ASSERT(PM6 == 0x57U);
+    TEST_ASSERT(PMC6 == 0x08U);
+    TEST_ASSERT(PU6 == 0x80U);
+}
+
+static void test_bus_recovery_gives_up_after_nine_clocks(void)
+{
+    test_setup();
+    test_waveform_t waveform;
+
+    MOCK_PORT_HoldLow(MOCK_PORT_LINE_SDA, 0U);
+    R_Config_IICA0_ResetBusLines();
+    test_dump("recovery_stuck");
+    test_measure(&waveform);
+    TEST_ASSERT(waveform.driven_high == 0U);
+
+    TEST_ASSERT(waveform.clocks == 9U);
+    TEST_ASSERT(waveform.rising == 10U);
+    TEST_ASSERT(waveform.stops == 0U);
+    TEST_ASSERT(MOCK_PORT_Lines() == MOCK_PORT_LINE_SCL);
+    TEST_ASSERT(R_Config_IICA0_SampleBusLines() == (uint8_t)R_IICA0_LINE_SCL);
+}
+
+static void test_vcd_export(void)
+{
+    test_setup();
+    char line[64];
+    long previous = -1L;
+    uint32_t stamps = 0U;
+    bool definitions = false;
+    FILE *stream = tmpfile();
+
+    TEST_ASSERT(stream != NULL);
+    (void)HAL_I2C_M_Probe(0x50U);
+    TEST_ASSERT(MOCK_PORT_WriteVcd(stream));
+    rewind(stream);
+
+    TEST_ASSERT(fgets(line, sizeof line, stream) != NULL);
+    TEST_ASSERT(strcmp(line, "$timescale 1ns $end\n") == 0);
+    while (fgets(line, sizeof line, stream) != NULL)
+    {
+        if (strcmp(line, "$enddefinitions $end\n") == 0)
+        {
+            definitions = true;
+        }
+        else if (line[0] == '#')
+        {
+            long stamp = 0L;
+
+            TEST_ASSERT(sscanf(line, "#%ld", &stamp) == 1);
+            TEST_ASSERT(stamp > previous);
+            previous = stamp;
+            stamps++;
+        }
+        else
+        {
+            /* No action required */
+        }
+    }
+    (void)fclose(stream);
+
+    TEST_ASSERT(definitions);
+    TEST_ASSERT(stamps > 20U);
+    TEST_ASSERT((uint32_t)previous == MOCK_PORT_CyclesToNs(MOCK_PORT_Now()));
+}
+
+static uint32_t g_async_callbacks = 0U;
+static bool g_async_success = true;
+
+static void test_async_callback(bool success, void *context)
+{
+    (void)context;
+    g_async_callbacks++;
+    g_async_success = success;
+}
+
+static void test_async_rejects_invalid_arguments(void)
+{
+    test_setup();
+    uint8_t buffer[2];
+
+    g_async_callbacks = 0U;
+    TEST_ASSERT(HAL_I2C_M_WriteReadAsync(0x50U, NULL, 0U, NULL, 0U, test_async_callback, NULL) == false);
+    TEST_ASSERT(HAL_I2C_M_WriteReadAsync(0x50U, NULL, 1U, buffer, 2U, test_async_callback, NULL) == false);
+    TEST_ASSERT(HAL_I2C_M_WriteReadAsync(0x50U, buffer, 1U, NULL, 2U, test_async_callback, NULL) == false);
+    TEST_ASSERT(g_async_callbacks == 0U);
+
+    /* A failed transfer is still accepted and reported through the callback */
+    TEST_ASSERT(HAL_I2C_M_WriteReadAsync(0x50U, buffer, 1U, NULL, 0U, test_async_callback, NULL) == true);
+    TEST_ASSERT(g_async_callbacks == 1U);
+    TEST_ASSERT(g_async_success == false);
+    TEST_ASSERT(HAL_I2C_M_IsBusy() == false);
+}
+
+static uint32_t g_stream_chunks = 0U;
+
+/* A slave that stretches SCL forever once the first chunk is in */
+static bool test_stream_consumer(const uint8_t *chunk, uint16_t length, void *context)
+{
+    (void)chunk;
+    (void)length;
+    (void)context;
+    if (g_stream_chunks == 0U)
+    {
+        MOCK_PORT_HoldLow(MOCK_PORT_LINE_SCL, 0U);
+    }
+    g_stream_chunks++;
+
+    return true;
+}
+
+static void test_stuck_clock_ends_stream_read(void)
+{
+    test_setup();
+    uint8_t chunk[4];
+
+    /* SDA low through the address byte and its ACK stands in for the slave */
+    g_stream_chunks = 0U;
+    MOCK_PORT_HoldLow(MOCK_PORT_LINE_SDA, 10U);
+    TEST_ASSERT(HAL_I2C_M_WriteReadStream(0x50U, NULL, 0U, 64UL, chunk, (uint16_t)sizeof chunk,
+                                          test_stream_consumer, NULL) == false);
+    test_dump("stream_stuck_clock");
+
+    /* The chunk read while SCL was stuck is never handed over */
+    TEST_ASSERT(g_stream_chunks == 1U);
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "standard_mode_probe_timing", test_standard_mode_probe_timing },
+    { "fast_mode_probe_timing", test_fast_mode_probe_timing },
+    { "data_changes_only_while_clock_low", test_data_changes_only_while_clock_low },
+    { "bus_recovery_stops_when_sda_released", test_bus_recovery_stops_when_sda_released },
+    { "bus_recovery_gives_up_after_nine_clocks", test_bus_recovery_gives_up_after_nine_clocks },
+    { "vcd_export", test_vcd_export },
+    { "async_rejects_invalid_arguments", test_async_rejects_invalid_arguments },
+    { "stuck_clock_ends_stream_read", test_stuck_clock_ends_stream_read }
+};
+
+int main(int argc, char **argv)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    if (argc > 1)
+    {
+        g_vcd_directory = argv[1];
+    }
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
@@ -0,0 +1,455 @@
+/*
+ * Cooperative scheduler on the host: ticks are driven by calling the tick
+ * ISR directly, so every deadline is deterministic.
+ *
+ *   cc -std=c99 -Wall -Wextra -Itests/mocks -Iinclude \
+ *       tests/hal_scheduler_test.c app/hal_scheduler.c
+ */
+#include "hal_scheduler.h"
+#include "r_cg_macrodriver.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_RECORDED_WORK (16U)
+
+/* 1 ms tick at 32 MHz: TM00 counts down from 31999 */
+#define TEST_TIMER_RELOAD  (31999U)
+
+volatile uint16_t g_mock_tcr00;
+volatile uint16_t g_mock_tdr00;
+volatile uint8_t  g_mock_tmif00;
+
+static uint16_t g_work[MAX_RECORDED_WORK];
+static uint32_t g_work_count = 0U;
+static uint32_t g_runs[3];
+static uint32_t g_pt_steps = 0U;
+static bool g_pt_abort = false;
+static bool g_check_in = true;
+static uint32_t g_failed_asserts = 0U;
+static uint32_t g_total_asserts = 0U;
+
+static void test_setup(void)
+{
+    memset(g_work, 0, sizeof g_work);
+    g_work_count = 0U;
+    memset(g_runs, 0, sizeof g_runs);
+    g_pt_steps = 0U;
+    g_pt_abort = false;
+    g_check_in = true;
+    g_mock_tdr00 = TEST_TIMER_RELOAD;
+    g_mock_tcr00 = TEST_TIMER_RELOAD;
+    g_mock_tmif00 = 0U;
+    (void)HAL_SCHED_Init(UINT16_C(1000));
+}
+
+/* Advance the tick counter to target, running the scheduler once per tick */
+static void test_run_to(uint32_t target)
+{
+    while (HAL_SCHED_GetTicks() < target)
+    {
+        HAL_SCHED_TickISR();
+        HAL_SCHED_RunOnce();
+    }
+}
+
+static void test_record_work(uint16_t argument)
+{
+    if (g_work_count < MAX_RECORDED_WORK)
+    {
+        g_work[g_work_count] = argument;
+    }
+
+    g_work_count++;
+}
+
+static void test_task_a(void)
+{
+    g_runs[0]++;
+    if (g_check_in)
+    {
+        HAL_SCHED_CheckIn();
+    }
+}
+
+static void test_task_b(void)
+{
+    g_runs[1]++;
+}
+
+static void test_task_c(void)
+{
+    g_runs[2]++;
+}
+
+/* Let ticks pass without running the scheduler, as a long task would */
+static void test_stall(uint32_t ticks)
+{
+    for (uint32_t count = 0U; count < ticks; count++)
+    {
+        HAL_SCHED_TickISR();
+    }
+}
+
+static hal_sched_pt_status_t test_coroutine(hal_sched_pt_t *pt)
+{
+    HAL_SCHED_PT_BEGIN(pt);
+
+    g_pt_steps++;
+    HAL_SCHED_PT_YIELD(pt);
+
+    g_pt_steps++;
+    if (g_pt_abort)
+    {
+        HAL_SCHED_PT_EXIT(pt);
+    }
+    HAL_SCHED_PT_SLEEP(pt, 10U);
+
+    g_pt_steps++;
+
+    HAL_SCHED_PT_END(pt);
+}
+
+#define TEST_ASSERT(expr)                                                                 \
+    do                                                                                    \
+    {                                                                                     \
+        g_total_asserts++;                                                                \
+        if (!(expr))                                                                      \
+        {                                                                                 \
+            g_failed_asserts++;                                                           \
+            printf("    Assertion failed: %s (line %u)\n", #expr, (unsigned)__LINE__);    \
+            return;                                                                       \
+        }                                                                                 \
+    } while (0)
+
+static void test_pt_yield_and_sleep(void)
+{
+    test_setup();
+    hal_sched_task_t tasks[] = {
+        { .coroutine = test_coroutine, .period_ticks = UINT16_C(5) }
+    };
+
+    HAL_SCHED_RegisterTasks(tasks, 1U);
+
+    test_run_to(4U);
+    TEST_ASSERT(g_pt_steps == 0U);
+    test_run_to(5U);
+    TEST_ASSERT(g_pt_steps == 1U);
+
+    /* A yield resumes on the very next tick, not a period later */
+    test_run_to(6U);
+    TEST_ASSERT(g_pt_steps == 2U);
+
+    /* The sleep condition is re-checked each period until tick 16 */
+    test_run_to(15U);
+    TEST_ASSERT(g_pt_steps == 2U);
+    test_run_to(16U);
+    TEST_ASSERT(g_pt_steps == 3U);
+
+    /* After the end the body starts over on the period grid */
+    test_run_to(20U);
+    TEST_ASSERT(g_pt_steps == 3U);
+    test_run_to(21U);
+    TEST_ASSERT(g_pt_steps == 4U);
+}
+
+static void test_pt_exit_restarts_from_top(void)
+{
+    test_setup();
+    hal_sched_task_t tasks[] = {
+        { .coroutine = test_coroutine, .period_ticks = UINT16_C(5) }
+    };
+
+    HAL_SCHED_RegisterTasks(tasks, 1U);
+    g_pt_abort = true;
+
+    test_run_to(6U);
+    TEST_ASSERT(g_pt_steps == 2U);
+    TEST_ASSERT(tasks[0].pt.resume_point == 0U);
+
+    test_run_to(10U);
+    TEST_ASSERT(g_pt_steps == 2U);
+    test_run_to(11U);
+    TEST_ASSERT(g_pt_steps == 3U);
+}
+
+static void test_defer_runs_in_order(void)
+{
+    test_setup();
+
+    TEST_ASSERT(HAL_SCHED_Defer(test_record_work, 10U));
+    TEST_ASSERT(HAL_SCHED_Defer(test_record_work, 20U));
+    TEST_ASSERT(HAL_SCHED_Defer(test_record_work, 30U));
+    TEST_ASSERT(HAL_SCHED_Defer(NULL, 40U) == false);
+    TEST_ASSERT(g_work_count == 0U);
+
+    /* Drained at the start of RunOnce, with or without registered tasks */
+    HAL_SCHED_RunOnce();
+    TEST_ASSERT(g_work_count == 3U);
+    TEST_ASSERT(g_work[0] == 10U);
+    TEST_ASSERT(g_work[1] == 20U);
+    TEST_ASSERT(g_work[2] == 30U);
+    TEST_ASSERT(HAL_SCHED_GetDeferDropCount() == 0U);
+}
+
+static void test_defer_full_queue_counts_drops(void)
+{
+    test_setup();
+
+    for (uint16_t index = 0U; index < (uint16_t)HAL_SCHED_WORK_QUEUE_DEPTH; index++)
+    {
+        TEST_ASSERT(HAL_SCHED_Defer(test_record_work, index));
+    }
+    TEST_ASSERT(HAL_SCHED_Defer(test_record_work, 100U) == false);
+    TEST_ASSERT(HAL_SCHED_Defer(test_record_work, 101U) == false);
+    TEST_ASSERT(HAL_SCHED_GetDeferDropCount() == 2U);
+
+    HAL_SCHED_RunOnce();
+    TEST_ASSERT(g_work_count == HAL_SCHED_WORK_QUEUE_DEPTH);
+    TEST_ASSERT(g_work[HAL_SCHED_WORK_QUEUE_DEPTH - 1U] == (uint16_t)(HAL_SCHED_WORK_QUEUE_DEPTH - 1U));
+
+    /* Slots are reusable once drained, across the position wrap as well */
+    for (uint16_t round = 0U; round < 300U; round++)
+    {
+        TEST_ASSERT(HAL_SCHED_Defer(test_record_work, round));
+        HAL_SCHED_RunOnce();
+    }
+    TEST_ASSERT(g_work_count == (HAL_SCHED_WORK_QUEUE_DEPTH + 300U));
+    TEST_ASSERT(HAL_SCHED_GetDeferDropCount() == 2U);
+}
+
+static void test_uptime_ms_and_us(void)
+{
+    test_setup();
+
+    test_run_to(1234U);
+    TEST_ASSERT(HAL_SCHED_GetUptimeMs() == 1234U);
+    TEST_ASSERT(HAL_SCHED_GetUptimeUs() == 1234000U);
+
+    /* Half way through the tick */
+    g_mock_tcr00 = (uint16_t)(TEST_TIMER_RELOAD - 16000U);
+    TEST_ASSERT(HAL_SCHED_GetUptimeUs() == 1234500U);
+
+    /* Reloaded but the tick ISR has not run yet: count the pending tick */
+    g_mock_tcr00 = (uint16_t)(TEST_TIMER_RELOAD - 32U);
+    g_mock_tmif00 = 1U;
+    TEST_ASSERT(HAL_SCHED_GetUptimeUs() == 1235001U);
+    g_mock_tmif00 = 0U;
+}
+
+static void test_init_rejects_other_tick_rate(void)
+{
+    test_setup();
+
+    test_run_to(20U);
+    /* The uptime math assumes the compile-time 1 kHz tick */
+    TEST_ASSERT(HAL_SCHED_Init(UINT16_C(500)) == false);
+    TEST_ASSERT(HAL_SCHED_Init(UINT16_C(0)) == false);
+    TEST_ASSERT(HAL_SCHED_GetTicks() == 20U);
+    TEST_ASSERT(HAL_SCHED_Init(UINT16_C(1000)) == true);
+    TEST_ASSERT(HAL_SCHED_GetTicks() == 0U);
+}
+
+static void test_tick_wrap(void)
+{
+    test_setup();
+    const uint32_t us_wrap_ticks = 4294968U;
+
+    /* Deadlines compare by signed distance, so they stay due across the wrap */
+    test_run_to(10U);
+    TEST_ASSERT(HAL_SCHED_IsTickDue(UINT32_C(0xFFFFFFF0)));
+    TEST_ASSERT(HAL_SCHED_IsTickDue(10U));
+    TEST_ASSERT(HAL_SCHED_IsTickDue(11U) == false);
+
+    /* The microsecond timestamp wraps after 2^32 us */
+    while (HAL_SCHED_GetTicks() < us_wrap_ticks)
+    {
+        HAL_SCHED_TickISR();
+    }
+    TEST_ASSERT(HAL_SCHED_GetUptimeMs() == us_wrap_ticks);
+    TEST_ASSERT(HAL_SCHED_GetUptimeUs() == (uint32_t)(us_wrap_ticks * 1000U));
+    TEST_ASSERT(HAL_SCHED_GetUptimeUs() < 1000U);
+}
+
+static void test_overrun_policies(void)
+{
+    test_setup();
+    hal_sched_task_t tasks[] = {
+        { .function = test_task_a, .period_ticks = UINT16_C(10), .overrun_policy = HAL_SCHED_OVERRUN_FIXED_RATE },
+        { .function = test_task_b, .period_ticks = UINT16_C(10), .overrun_policy = HAL_SCHED_OVERRUN_CATCH_UP },
+        { .function = test_task_c, .period_ticks = UINT16_C(10), .overrun_policy = HAL_SCHED_OVERRUN_SKIP_TO_NOW }
+    };
+
+    HAL_SCHED_RegisterTasks(tasks, 3U);
+
+    /* First deadline at 10, first run at 35: 25 ticks late, two periods missed */
+    test_stall(35U);
+    HAL_SCHED_RunOnce();
+    TEST_ASSERT(g_runs[0] == 1U);
+    TEST_ASSERT(g_runs[1] == 1U);
+    TEST_ASSERT(g_runs[2] == 1U);
+    TEST_ASSERT(tasks[0].max_lateness_ticks == 25U);
+
+    TEST_ASSERT(tasks[0].next_deadline == 40U);
+    TEST_ASSERT(tasks[0].skipped_periods == 2U);
+    TEST_ASSERT(tasks[1].next_deadline == 20U);
+    TEST_ASSERT(tasks[1].skipped_periods == 0U);
+    TEST_ASSERT(tasks[2].next_deadline == 45U);
+    TEST_ASSERT(tasks[2].skipped_periods == 2U);
+
+    /* CATCH_UP runs back to back until it is on time again */
+    HAL_SCHED_RunOnce();
+    HAL_SCHED_RunOnce();
+    HAL_SCHED_RunOnce();
+    TEST_ASSERT(g_runs[0] == 1U);
+    TEST_ASSERT(g_runs[1] == 3U);
+    TEST_ASSERT(g_runs[2] == 1U);
+    TEST_ASSERT(tasks[1].next_deadline == 40U);
+
+    test_run_to(45U);
+    TEST_ASSERT(g_runs[0] == 2U);
+    TEST_ASSERT(g_runs[1] == 4U);
+    TEST_ASSERT(g_runs[2] == 2U);
+}
+
+static void test_catch_up_backlog_is_bounded(void)
+{
+    test_setup();
+    hal_sched_task_t tasks[] = {
+        { .function = test_task_a, .period_ticks = UINT16_C(10), .overrun_policy = HAL_SCHED_OVERRUN_CATCH_UP }
+    };
+
+    HAL_SCHED_RegisterTasks(tasks, 1U);
+
+    /* 12 periods missed; only HAL_SCHED_CATCH_UP_MAX_PERIODS are replayed */
+    test_stall(135U);
+    for (uint8_t count = 0U; count < 20U; count++)
+    {
+        HAL_SCHED_RunOnce();
+    }
+    TEST_ASSERT(g_runs[0] == (1U + HAL_SCHED_CATCH_UP_MAX_PERIODS));
+    TEST_ASSERT(tasks[0].skipped_periods == (12U - HAL_SCHED_CATCH_UP_MAX_PERIODS));
+    TEST_ASSERT(tasks[0].next_deadline == 140U);
+}
+
+static void test_auto_phase_spreads_tasks(void)
+{
+    test_setup();
+    hal_sched_task_t tasks[] = {
+        { .function = test_task_a, .period_ticks = UINT16_C(4), .phase_ticks = HAL_SCHED_PHASE_AUTO },
+        { .function = test_task_b, .period_ticks = UINT16_C(4), .phase_ticks = UINT16_C(0) },
+        { .function = test_task_c, .period_ticks = UINT16_C(4), .phase_ticks = HAL_SCHED_PHASE_AUTO },
+        { .function = test_task_c, .period_ticks = UINT16_C(2), .phase_ticks = HAL_SCHED_PHASE_AUTO }
+    };
+
+    HAL_SCHED_RegisterTasks(tasks, 4U);
+
+    /* The fixed phase is placed first; the auto tasks steer around it */
+    TEST_ASSERT(tasks[1].next_deadline == 4U);
+    TEST_ASSERT(tasks[0].next_deadline == 5U);
+    TEST_ASSERT(tasks[2].next_deadline == 6U);
+    TEST_ASSERT(tasks[3].next_deadline == 3U);
+
+    /* Over a window every tick carries at most two task runs */
+    for (uint32_t tick = 1U; tick <= 32U; tick++)
+    {
+        const uint32_t before = g_runs[0] + g_runs[1] + g_runs[2];
+
+        test_run_to(tick);
+        TEST_ASSERT((g_runs[0] + g_runs[1] + g_runs[2] - before) <= 2U);
+    }
+}
+
+static void test_supervisor_records_first_starvation(void)
+{
+    test_setup();
+    hal_sched_task_t tasks[] = {
+        { .function = test_task_b, .period_ticks = UINT16_C(1) },
+        { .function = test_task_a, .period_ticks = UINT16_C(2), .liveness_ticks = UINT16_C(5) }
+    };
+    hal_sched_starvation_record_t record;
+
+    HAL_SCHED_ClearStarvationRecord();
+    HAL_SCHED_RegisterTasks(tasks, 2U);
+    TEST_ASSERT(HAL_SCHED_GetStarvationRecord(&record) == false);
+
+    test_run_to(50U);
+    TEST_ASSERT(HAL_SCHED_SupervisorHealthy());
+
+    /* Last check-in at 50; silent for more than 5 ticks at 56 */
+    g_check_in = false;
+    test_run_to(55U);
+    TEST_ASSERT(HAL_SCHED_SupervisorHealthy());
+    test_run_to(56U);
+    TEST_ASSERT(HAL_SCHED_SupervisorHealthy() == false);
+    TEST_ASSERT(HAL_SCHED_GetStarvationRecord(&record));
+    TEST_ASSERT(record.task_index == 1U);
+    TEST_ASSERT(record.silent_ticks == 6U);
+    TEST_ASSERT(record.uptime_ms == 56U);
+
+    /* Later expiries keep the first offender */
+    test_run_to(80U);
+    TEST_ASSERT(HAL_SCHED_SupervisorHealthy() == false);
+    TEST_ASSERT(HAL_SCHED_GetStarvationRecord(&record));
+    TEST_ASSERT(record.silent_ticks == 6U);
+
+    /* Clearing drops the record */
+    HAL_SCHED_ClearStarvationRecord();
+    TEST_ASSERT(HAL_SCHED_GetStarvationRecord(&record) == false);
+
+    /* Checking in again restores health */
+    g_check_in = true;
+    test_run_to(82U);
+    TEST_ASSERT(HAL_SCHED_SupervisorHealthy());
+}
+
+typedef void (*test_fn_t)(void);
+
+typedef struct
+{
+    const char *name;
+    test_fn_t   function;
+} test_case_t;
+
+static test_case_t g_tests[] = {
+    { "pt_yield_and_sleep", test_pt_yield_and_sleep },
+    { "pt_exit_restarts_from_top", test_pt_exit_restarts_from_top },
+    { "defer_runs_in_order", test_defer_runs_in_order },
+    { "defer_full_queue_counts_drops", test_defer_full_queue_counts_drops },
+    { "uptime_ms_and_us", test_uptime_ms_and_us },
+    { "init_rejects_other_tick_rate", test_init_rejects_other_tick_rate },
+    { "tick_wrap", test_tick_wrap },
+    { "overrun_policies", test_overrun_policies },
+    { "catch_up_backlog_is_bounded", test_catch_up_backlog_is_bounded },
+    { "auto_phase_spreads_tasks", test_auto_phase_spreads_tasks },
+    { "supervisor_records_first_starvation", test_supervisor_records_first_starvation }
+};
+
+int main(void)
+{
+    const size_t total_tests = sizeof g_tests / sizeof g_tests[0];
+    size_t passed_tests = 0U;
+
+    for (size_t index = 0U; index < total_tests; index++)
+    {
+        printf("[ RUN      ] %s\n", g_tests[index].name);
+        const uint32_t failed_before = g_failed_asserts;
+        g_tests[index].function();
+        if (g_failed_asserts == failed_before)
+        {
+            printf("[     PASS ] %s\n", g_tests[index].name);
+            passed_tests++;
+        }
+        else
+        {
+            printf("[   FAILED ] %s\n", g_tests[index].name);
+        }
+    }
+
+    printf("[ SUMMARY  ] %zu / %zu tests passed (%u assertions)\n",
+           passed_tests, total_tests, (unsigned)g_total_asserts);
+
+    return (g_failed_asserts == 0U) ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+#ifndef HAL_GPIO_BOARD_H
+#define HAL_GPIO_BOARD_H
+
+#include <stdint.h>
+
+#include "hal_gpio.h"
+
+/*
+ * Host board for the GPIO tests: found ahead of include/hal_gpio_board.h
+ * when tests/mocks comes first on the include path. The port, mode and
+ * pull-up registers are plain bytes in mock_gpio_ports.c.
+ */
+extern volatile uint8_t MOCK_P0;
+extern volatile uint8_t MOCK_PM0;
+extern volatile uint8_t MOCK_PU0;
+extern volatile uint8_t MOCK_P1;
+extern volatile uint8_t MOCK_PM1;
+
+#define HAL_GPIO_PIN_TABLE(ENTRY)                                                                  \
+    ENTRY(HAL_GPIO_PIN_BUTTON, &MOCK_P0, &MOCK_PM0, &MOCK_PU0, NULL, (uint8_t)(1U << 0),           \
+          HAL_GPIO_MODE_INPUT_PULLUP, HAL_GPIO_LEVEL_LOW, true)                                    \
+    ENTRY(HAL_GPIO_PIN_DOOR, &MOCK_P0, &MOCK_PM0, &MOCK_PU0, NULL, (uint8_t)(1U << 1),             \
+          HAL_GPIO_MODE_INPUT, HAL_GPIO_LEVEL_LOW, false)                                          \
+    ENTRY(HAL_GPIO_PIN_LED, &MOCK_P0, &MOCK_PM0, &MOCK_PU0, NULL, (uint8_t)(1U << 7),              \
+          HAL_GPIO_MODE_OUTPUT, HAL_GPIO_LEVEL_LOW, false)                                         \
+    ENTRY(HAL_GPIO_PIN_SENSOR, &MOCK_P1, &MOCK_PM1, NULL, NULL, (uint8_t)(1U << 4),                \
+          HAL_GPIO_MODE_INPUT, HAL_GPIO_LEVEL_LOW, false)
+
+/* Set the level the pin reads with, as the outside world would */
+void MOCK_GPIO_Drive(volatile uint8_t *port_reg, uint8_t mask, bool high);
+
+#endif /* HAL_GPIO_BOARD_H */
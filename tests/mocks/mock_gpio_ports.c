@@ -0,0 +1,19 @@
+#include "hal_gpio_board.h"
+
+volatile uint8_t MOCK_P0;
+volatile uint8_t MOCK_PM0;
+volatile uint8_t MOCK_PU0;
+volatile uint8_t MOCK_P1;
+volatile uint8_t MOCK_PM1;
+
+void MOCK_GPIO_Drive(volatile uint8_t *port_reg, uint8_t mask, bool high)
+{
+    if (high)
+    {
+        *port_reg |= mask;
+    }
+    else
+    {
+        *port_reg &= (uint8_t)(~mask);
+    }
+}
@@ -0,0 +1,225 @@
+#include "mock_hal_eeprom.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define MOCK_HAL_EEPROM_SIZE  (65536UL)
+
+static uint8_t g_memory[MOCK_HAL_EEPROM_SIZE];
+static mock_hal_eeprom_state_t g_state;
+static uint32_t g_writes_left = UINT32_MAX;
+
+/* Pending asynchronous write; programmed once its write cycle is over */
+static const uint8_t *g_async_data = NULL;
+static uint32_t g_async_address = 0UL;
+static uint16_t g_async_length = 0U;
+static bool g_async_programmed = true;
+static bool g_async_failed = false;
+static hal_i2c_m_eeprom_status_t g_async_status = HAL_I2C_M_EEPROM_IDLE;
+static hal_i2c_m_callback_t g_async_callback = NULL;
+static void *g_async_context = NULL;
+
+static bool mock_hal_eeprom_in_range(const hal_i2c_m_eeprom_t *device, uint32_t address, uint32_t length)
+{
+    return (device != NULL) &&
+           (length > 0UL) &&
+           (address < device->size_bytes) &&
+           (length <= (device->size_bytes - address)) &&
+           ((address + length) <= MOCK_HAL_EEPROM_SIZE);
+}
+
+void MOCK_HAL_EEPROM_Reset(uint8_t fill)
+{
+    memset(g_memory, fill, sizeof g_memory);
+    MOCK_HAL_EEPROM_ResetCounters();
+}
+
+void MOCK_HAL_EEPROM_ResetCounters(void)
+{
+    memset(&g_state, 0, sizeof g_state);
+    g_writes_left = UINT32_MAX;
+    g_async_programmed = true;
+    g_async_failed = false;
+    g_async_status = HAL_I2C_M_EEPROM_IDLE;
+    g_async_callback = NULL;
+}
+
+static bool mock_hal_eeprom_take_write(void)
+{
+    if (g_writes_left == 0UL)
+    {
+        return false;
+    }
+    if (g_writes_left != UINT32_MAX)
+    {
+        g_writes_left--;
+    }
+
+    return true;
+}
+
+static bool mock_hal_eeprom_device_busy(void)
+{
+    return !g_async_programmed;
+}
+
+/* The page is programmed from the buffer as it is when the write cycle ends */
+static void mock_hal_eeprom_program_async(void)
+{
+    if (g_async_programmed)
+    {
+        return;
+    }
+
+    g_async_programmed = true;
+    if (!mock_hal_eeprom_take_write())
+    {
+        g_async_failed = true;
+        return;
+    }
+
+    memcpy(&g_memory[g_async_address], g_async_data, g_async_length);
+    g_state.writes++;
+    g_state.bytes_written += g_async_length;
+}
+
+void MOCK_HAL_EEPROM_CompleteAsync(void)
+{
+    if (g_async_status != HAL_I2C_M_EEPROM_BUSY)
+    {
+        return;
+    }
+
+    mock_hal_eeprom_program_async();
+    g_async_status = g_async_failed ? HAL_I2C_M_EEPROM_FAILED : HAL_I2C_M_EEPROM_DONE;
+    g_async_callback(!g_async_failed, g_async_context);
+}
+
+void MOCK_HAL_EEPROM_FailWritesAfter(uint32_t count)
+{
+    g_writes_left = count;
+}
+
+uint8_t *MOCK_HAL_EEPROM_GetMemory(void)
+{
+    return g_memory;
+}
+
+const mock_hal_eeprom_state_t *MOCK_HAL_EEPROM_GetState(void)
+{
+    return &g_state;
+}
+
+bool HAL_I2C_M_EEPROM_Write(const hal_i2c_m_eeprom_t *device,
+                            uint32_t memory_address,
+                            const uint8_t *data,
+                            uint16_t length)
+{
+    if ((data == NULL) || !mock_hal_eeprom_in_range(device, memory_address, length))
+    {
+        return false;
+    }
+
+    if (mock_hal_eeprom_device_busy() || !mock_hal_eeprom_take_write())
+    {
+        return false;
+    }
+
+    memcpy(&g_memory[memory_address], data, length);
+    g_state.writes++;
+    g_state.bytes_written += length;
+
+    return true;
+}
+
+bool HAL_I2C_M_EEPROM_Read(const hal_i2c_m_eeprom_t *device,
+                           uint32_t memory_address,
+                           uint8_t *data,
+                           uint16_t length)
+{
+    if ((data == NULL) || !mock_hal_eeprom_in_range(device, memory_address, length) ||
+        mock_hal_eeprom_device_busy())
+    {
+        return false;
+    }
+
+    memcpy(data, &g_memory[memory_address], length);
+    g_state.reads++;
+    g_state.bytes_read += length;
+
+    return true;
+}
+
+bool HAL_I2C_M_EEPROM_ReadStream(const hal_i2c_m_eeprom_t *device,
+                                 uint32_t memory_address,
+                                 uint32_t length,
+                                 uint8_t *chunk,
+                                 uint16_t chunk_size,
+                                 hal_i2c_m_chunk_fn_t consumer,
+                                 void *context)
+{
+    if ((chunk == NULL) || (chunk_size == 0U) || (consumer == NULL) ||
+        !mock_hal_eeprom_in_range(device, memory_address, length))
+    {
+        return false;
+    }
+
+    uint32_t done = 0UL;
+
+    g_state.reads++;
+
+    while (done < length)
+    {
+        const uint16_t piece = ((length - done) < chunk_size) ? (uint16_t)(length - done) : chunk_size;
+
+        memcpy(chunk, &g_memory[memory_address + done], piece);
+        g_state.bytes_read += piece;
+        done += piece;
+
+        if (!consumer(chunk, piece, context))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool HAL_I2C_M_EEPROM_WriteAsync(const hal_i2c_m_eeprom_t *device,
+                                 uint32_t memory_address,
+                                 const uint8_t *data,
+                                 uint16_t length,
+                                 hal_i2c_m_callback_t callback,
+                                 void *context)
+{
+    if ((data == NULL) || (callback == NULL) || (g_async_status == HAL_I2C_M_EEPROM_BUSY) ||
+        !mock_hal_eeprom_in_range(device, memory_address, length))
+    {
+        return false;
+    }
+
+    g_async_address    = memory_address;
+    g_async_data       = data;
+    g_async_length     = length;
+    g_async_programmed = false;
+    g_async_failed     = false;
+    g_async_status     = HAL_I2C_M_EEPROM_BUSY;
+    g_async_callback   = callback;
+    g_async_context    = context;
+    g_state.async_writes++;
+
+    return true;
+}
+
+bool HAL_I2C_M_EEPROM_IsBusy(void)
+{
+    return (g_async_status == HAL_I2C_M_EEPROM_BUSY);
+}
+
+bool HAL_I2C_M_EEPROM_WaitReady(const hal_i2c_m_eeprom_t *device)
+{
+    g_state.ready_waits++;
+    mock_hal_eeprom_program_async();
+
+    return (device != NULL);
+}
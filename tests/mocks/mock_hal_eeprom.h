@@ -0,0 +1,37 @@
+#ifndef MOCK_HAL_EEPROM_H
+#define MOCK_HAL_EEPROM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hal_i2c_master.h"
+
+typedef struct
+{
+    uint32_t reads;          /* read transactions */
+    uint32_t bytes_read;
+    uint32_t writes;         /* write calls */
+    uint32_t bytes_written;
+    uint32_t async_writes;   /* HAL_I2C_M_EEPROM_WriteAsync calls accepted */
+    uint32_t ready_waits;    /* HAL_I2C_M_EEPROM_WaitReady calls */
+} mock_hal_eeprom_state_t;
+
+/*
+ * RAM-backed stand-in for the HAL_I2C_M_EEPROM_* calls. The memory outlives
+ * MOCK_HAL_EEPROM_ResetCounters so a test can "reboot" on the same contents.
+ */
+void MOCK_HAL_EEPROM_Reset(uint8_t fill);
+void MOCK_HAL_EEPROM_ResetCounters(void);
+/* Fail every write after the next count writes (a power cut); UINT32_MAX disables */
+void MOCK_HAL_EEPROM_FailWritesAfter(uint32_t count);
+/*
+ * An accepted HAL_I2C_M_EEPROM_WriteAsync leaves the device busy: reads and
+ * writes fail until HAL_I2C_M_EEPROM_WaitReady waits out the write cycle or
+ * this call stands in for HAL_I2C_M_EEPROM_Task finishing the job and
+ * running its callback.
+ */
+void MOCK_HAL_EEPROM_CompleteAsync(void);
+uint8_t *MOCK_HAL_EEPROM_GetMemory(void);
+const mock_hal_eeprom_state_t *MOCK_HAL_EEPROM_GetState(void);
+
+#endif /* MOCK_HAL_EEPROM_H */
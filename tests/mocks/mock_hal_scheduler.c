@@ -2,10 +2,12 @@
 #include "mock_hal_scheduler.h"
 
 static uint32_t g_uptime_ms = 0U;
+static uint32_t g_uptime_us_drift = 0U;
 
 void MOCK_HAL_SCHED_Reset(void)
 {
     g_uptime_ms = 0U;
+    g_uptime_us_drift = 0U;
 }
 
 void MOCK_HAL_SCHED_SetUptime(uint32_t value)
@@ -21,4 +23,11 @@ void MOCK_HAL_SCHED_Advance(uint32_t delta_ms)
 uint32_t HAL_SCHED_GetUptimeMs(void)
 {
     return g_uptime_ms;
-}
\ No newline at end of file
+}
+
+/* Moves forward on every read so microsecond busy-waits terminate. */
+uint32_t HAL_SCHED_GetUptimeUs(void)
+{
+    g_uptime_us_drift += MOCK_HAL_SCHED_US_PER_READ;
+    return (g_uptime_ms * 1000U) + g_uptime_us_drift;
+}
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
+#define MOCK_HAL_SCHED_US_PER_READ  (50U)
+
 void MOCK_HAL_SCHED_Reset(void);
 void MOCK_HAL_SCHED_SetUptime(uint32_t value);
 void MOCK_HAL_SCHED_Advance(uint32_t delta_ms);
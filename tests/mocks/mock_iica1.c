@@ -0,0 +1,240 @@
+#include "mock_iica1.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define MOCK_IICCTL0_WREL  (uint8_t)(1U << 5)
+#define MOCK_IICCTL0_ACKE  (uint8_t)(1U << 2)
+#define MOCK_IICCTL0_STT   (uint8_t)(1U << 1)
+#define MOCK_IICCTL0_SPT   (uint8_t)(1U << 0)
+
+#define MOCK_IICS_MSTS     (uint8_t)(1U << 7)
+#define MOCK_IICS_TRC      (uint8_t)(1U << 3)
+#define MOCK_IICS_ACKD     (uint8_t)(1U << 2)
+#define MOCK_IICS_STD      (uint8_t)(1U << 1)
+#define MOCK_IICS_SPD      (uint8_t)(1U << 0)
+
+#define MOCK_IICF_IICBSY   (uint8_t)(1U << 6)
+
+typedef enum
+{
+    MOCK_IICA1_BUS_IDLE = 0,
+    MOCK_IICA1_BUS_ADDRESS,
+    MOCK_IICA1_BUS_TRANSMIT,
+    MOCK_IICA1_BUS_RECEIVE,
+    MOCK_IICA1_BUS_HOLD
+} mock_iica1_bus_phase_t;
+
+typedef struct
+{
+    volatile uint8_t       regs[MOCK_IICA1_REG_COUNT];
+    mock_iica1_bus_phase_t phase;
+    mock_iica1_isr_t       isr;
+    mock_iica1_hook_t      hook;
+
+    uint8_t               *memory;
+    uint16_t               memory_size;
+    uint16_t               pointer;
+    uint8_t                device_address7;
+    bool                   pointer_loaded;
+
+    mock_iica1_state_t     state;
+} mock_iica1_t;
+
+volatile uint8_t IICAMK1 = 1U;
+volatile uint8_t IICAIF1 = 0U;
+
+static mock_iica1_t g_mock;
+
+static void mock_iica1_apply_control(void)
+{
+    volatile uint8_t *control = &g_mock.regs[MOCK_IICA1_REG_IICCTL0];
+
+    if ((*control & MOCK_IICCTL0_SPT) != 0U)
+    {
+        *control &= (uint8_t)(~MOCK_IICCTL0_SPT);
+        if (g_mock.phase != MOCK_IICA1_BUS_IDLE)
+        {
+            g_mock.state.stops++;
+        }
+        g_mock.regs[MOCK_IICA1_REG_IICS] = MOCK_IICS_SPD;
+        g_mock.regs[MOCK_IICA1_REG_IICF] &= (uint8_t)(~MOCK_IICF_IICBSY);
+        g_mock.phase = MOCK_IICA1_BUS_IDLE;
+    }
+
+    if ((*control & MOCK_IICCTL0_STT) != 0U)
+    {
+        *control &= (uint8_t)(~MOCK_IICCTL0_STT);
+        g_mock.state.starts++;
+        g_mock.regs[MOCK_IICA1_REG_IICS] = (uint8_t)(MOCK_IICS_MSTS | MOCK_IICS_STD);
+        g_mock.regs[MOCK_IICA1_REG_IICF] |= MOCK_IICF_IICBSY;
+        g_mock.phase = MOCK_IICA1_BUS_ADDRESS;
+    }
+}
+
+static void mock_iica1_raise_interrupt(void)
+{
+    if ((IICAMK1 == 0U) && (g_mock.isr != NULL))
+    {
+        IICAIF1 = 0U;
+        g_mock.state.interrupts++;
+        g_mock.isr();
+    }
+    else
+    {
+        IICAIF1 = 1U;
+    }
+}
+
+static uint8_t mock_iica1_device_read(void)
+{
+    uint8_t value = 0xFFU;
+
+    if ((g_mock.memory != NULL) && (g_mock.memory_size > 0U))
+    {
+        value = g_mock.memory[g_mock.pointer % g_mock.memory_size];
+        g_mock.pointer = (uint16_t)((g_mock.pointer + 1U) % g_mock.memory_size);
+    }
+
+    return value;
+}
+
+static void mock_iica1_device_write(uint8_t value)
+{
+    if (!g_mock.pointer_loaded)
+    {
+        g_mock.pointer = value;
+        g_mock.pointer_loaded = true;
+    }
+    else if ((g_mock.memory != NULL) && (g_mock.memory_size > 0U))
+    {
+        g_mock.memory[g_mock.pointer % g_mock.memory_size] = value;
+        g_mock.pointer = (uint16_t)((g_mock.pointer + 1U) % g_mock.memory_size);
+    }
+    else
+    {
+        /* No action required */
+    }
+}
+
+void MOCK_IICA1_Reset(void)
+{
+    (void)memset(&g_mock, 0, sizeof g_mock);
+    g_mock.device_address7 = 0xFFU;
+    IICAMK1 = 1U;
+    IICAIF1 = 0U;
+}
+
+void MOCK_IICA1_SetInterruptHandler(mock_iica1_isr_t handler)
+{
+    g_mock.isr = handler;
+}
+
+void MOCK_IICA1_SetServiceHook(mock_iica1_hook_t hook)
+{
+    g_mock.hook = hook;
+}
+
+void MOCK_IICA1_AttachDevice(uint8_t address7, uint8_t *memory, uint16_t size)
+{
+    g_mock.device_address7 = address7;
+    g_mock.memory          = memory;
+    g_mock.memory_size     = size;
+    g_mock.pointer         = 0U;
+}
+
+uint8_t MOCK_IICA1_Peek(mock_iica1_reg_t reg)
+{
+    return (reg < MOCK_IICA1_REG_COUNT) ? g_mock.regs[reg] : 0U;
+}
+
+const mock_iica1_state_t *MOCK_IICA1_GetState(void)
+{
+    /* A stop requested by the last ISR is only latched on the next access */
+    mock_iica1_apply_control();
+
+    return &g_mock.state;
+}
+
+volatile uint8_t *MOCK_IICA1_Access(mock_iica1_reg_t reg)
+{
+    mock_iica1_apply_control();
+
+    return &g_mock.regs[(reg < MOCK_IICA1_REG_COUNT) ? reg : MOCK_IICA1_REG_IICA];
+}
+
+/*
+ * Complete whatever the driver last triggered (address, data byte or
+ * receive release) as if nine SCL clocks had elapsed, then raise INTIICA1.
+ */
+bool MOCK_IICA1_Service(void)
+{
+    bool progressed = true;
+    volatile uint8_t *status = &g_mock.regs[MOCK_IICA1_REG_IICS];
+
+    mock_iica1_apply_control();
+
+    switch (g_mock.phase)
+    {
+        case MOCK_IICA1_BUS_ADDRESS:
+        {
+            const uint8_t address_byte = g_mock.regs[MOCK_IICA1_REG_IICA];
+            const bool    read = ((address_byte & 0x01U) != 0U);
+            const bool    ack  = ((uint8_t)(address_byte >> 1) == g_mock.device_address7);
+
+            g_mock.pointer_loaded = read ? g_mock.pointer_loaded : false;
+            if (!ack)
+            {
+                g_mock.state.address_nacks++;
+                g_mock.phase = MOCK_IICA1_BUS_HOLD;
+                *status = (uint8_t)(MOCK_IICS_MSTS | MOCK_IICS_TRC);
+            }
+            else
+            {
+                g_mock.phase = read ? MOCK_IICA1_BUS_RECEIVE : MOCK_IICA1_BUS_TRANSMIT;
+                *status = (uint8_t)(MOCK_IICS_MSTS | MOCK_IICS_ACKD | (read ? 0U : MOCK_IICS_TRC));
+            }
+            mock_iica1_raise_interrupt();
+            break;
+        }
+        case MOCK_IICA1_BUS_TRANSMIT:
+            mock_iica1_device_write(g_mock.regs[MOCK_IICA1_REG_IICA]);
+            g_mock.state.bytes_written++;
+            *status = (uint8_t)(MOCK_IICS_MSTS | MOCK_IICS_TRC | MOCK_IICS_ACKD);
+            mock_iica1_raise_interrupt();
+            break;
+        case MOCK_IICA1_BUS_RECEIVE:
+            if ((g_mock.regs[MOCK_IICA1_REG_IICCTL0] & MOCK_IICCTL0_WREL) != 0U)
+            {
+                const bool ack = ((g_mock.regs[MOCK_IICA1_REG_IICCTL0] & MOCK_IICCTL0_ACKE) != 0U);
+
+                g_mock.regs[MOCK_IICA1_REG_IICCTL0] &= (uint8_t)(~MOCK_IICCTL0_WREL);
+                g_mock.regs[MOCK_IICA1_REG_IICA] = mock_iica1_device_read();
+                g_mock.state.bytes_read++;
+                if (!ack)
+                {
+                    g_mock.state.master_nacks++;
+                    g_mock.phase = MOCK_IICA1_BUS_HOLD;
+                }
+                *status = MOCK_IICS_MSTS;
+                mock_iica1_raise_interrupt();
+            }
+            else
+            {
+                progressed = false;
+            }
+            break;
+        case MOCK_IICA1_BUS_IDLE:
+        case MOCK_IICA1_BUS_HOLD:
+        default:
+            progressed = false;
+            break;
+    }
+
+    if (progressed && (g_mock.hook != NULL))
+    {
+        g_mock.hook();
+    }
+
+    return progressed;
+}
@@ -0,0 +1,31 @@
+#ifndef MOCK_IICA1_H
+#define MOCK_IICA1_H
+
+#include <stdint.h>
+
+#include "r_cg_macrodriver.h"
+
+typedef struct
+{
+    uint32_t starts;
+    uint32_t stops;
+    uint32_t interrupts;
+    uint32_t bytes_written;
+    uint32_t bytes_read;
+    uint32_t address_nacks;
+    uint32_t master_nacks;
+} mock_iica1_state_t;
+
+typedef void (*mock_iica1_isr_t)(void);
+
+/* Called after every completed bus phase, e.g. to let time pass per byte. */
+typedef void (*mock_iica1_hook_t)(void);
+
+void MOCK_IICA1_Reset(void);
+void MOCK_IICA1_SetInterruptHandler(mock_iica1_isr_t handler);
+void MOCK_IICA1_SetServiceHook(mock_iica1_hook_t hook);
+void MOCK_IICA1_AttachDevice(uint8_t address7, uint8_t *memory, uint16_t size);
+uint8_t MOCK_IICA1_Peek(mock_iica1_reg_t reg);
+const mock_iica1_state_t *MOCK_IICA1_GetState(void);
+
+#endif /* MOCK_IICA1_H */
@@ -0,0 +1,200 @@
+#include "mock_port.h"
+
+#include <string.h>
+
+volatile uint8_t g_mock_port_regs[MOCK_PORT_REG_COUNT];
+
+static const uint8_t g_mock_port_reset_values[MOCK_PORT_REG_COUNT] = { 0xFFU, 0xFFU, 0x00U, 0x00U };
+static const char *const g_mock_port_reg_names[MOCK_PORT_REG_COUNT] = { "P6", "PM6", "PMC6", "PU6" };
+
+static mock_port_event_t g_mock_port_events[MOCK_PORT_MAX_EVENTS];
+static uint32_t g_mock_port_event_count = 0U;
+static bool g_mock_port_overflow = false;
+static uint32_t g_mock_port_cycle = 0U;
+static uint8_t g_mock_port_last_regs[MOCK_PORT_REG_COUNT];
+static uint8_t g_mock_port_lines = 0U;
+static uint8_t g_mock_port_held = 0U;
+static uint8_t g_mock_port_hold_clocks = 0U;
+
+static uint8_t mock_port_resolve(const uint8_t *regs)
+{
+    const uint8_t driven_low = (uint8_t)(~regs[MOCK_PORT_REG_PM6] & ~regs[MOCK_PORT_REG_P6]);
+
+    return (uint8_t)((MOCK_PORT_LINE_SDA | MOCK_PORT_LINE_SCL) & ~driven_low & ~g_mock_port_held);
+}
+
+static void mock_port_append(void)
+{
+    if (g_mock_port_event_count >= MOCK_PORT_MAX_EVENTS)
+    {
+        g_mock_port_overflow = true;
+        return;
+    }
+
+    mock_port_event_t *event = &g_mock_port_events[g_mock_port_event_count];
+
+    event->cycle = g_mock_port_cycle;
+    (void)memcpy(event->regs, g_mock_port_last_regs, MOCK_PORT_REG_COUNT);
+    event->lines = g_mock_port_lines;
+    g_mock_port_event_count++;
+}
+
+/*
+ * Record whatever the code under test wrote since the last call. Writes in
+ * between share one event, in the order the registers are listed.
+ */
+static void mock_port_sync(void)
+{
+    uint8_t regs[MOCK_PORT_REG_COUNT];
+
+    for (uint8_t index = 0U; index < (uint8_t)MOCK_PORT_REG_COUNT; index++)
+    {
+        regs[index] = g_mock_port_regs[index];
+    }
+
+    uint8_t lines = mock_port_resolve(regs);
+
+    if ((g_mock_port_hold_clocks != 0U) &&
+        ((g_mock_port_lines & MOCK_PORT_LINE_SCL) == 0U) && ((lines & MOCK_PORT_LINE_SCL) != 0U))
+    {
+        g_mock_port_hold_clocks--;
+        if (g_mock_port_hold_clocks == 0U)
+        {
+            g_mock_port_held = 0U;
+            lines = mock_port_resolve(regs);
+        }
+    }
+
+    if ((memcmp(regs, g_mock_port_last_regs, MOCK_PORT_REG_COUNT) != 0) || (lines != g_mock_port_lines))
+    {
+        (void)memcpy(g_mock_port_last_regs, regs, MOCK_PORT_REG_COUNT);
+        g_mock_port_lines = lines;
+        mock_port_append();
+    }
+}
+
+void MOCK_PORT_Reset(void)
+{
+    for (uint8_t index = 0U; index < (uint8_t)MOCK_PORT_REG_COUNT; index++)
+    {
+        g_mock_port_regs[index] = g_mock_port_reset_values[index];
+    }
+
+    g_mock_port_event_count = 0U;
+    g_mock_port_overflow = false;
+    g_mock_port_cycle = 0U;
+    g_mock_port_held = 0U;
+    g_mock_port_hold_clocks = 0U;
+    (void)memcpy(g_mock_port_last_regs, g_mock_port_reset_values, MOCK_PORT_REG_COUNT);
+    g_mock_port_lines = mock_port_resolve(g_mock_port_reset_values);
+    mock_port_append();
+}
+
+void MOCK_PORT_Elapse(uint32_t cycles)
+{
+    mock_port_sync();
+    g_mock_port_cycle += cycles;
+}
+
+uint32_t MOCK_PORT_Now(void)
+{
+    return g_mock_port_cycle;
+}
+
+uint8_t MOCK_PORT_ReadP6(void)
+{
+    mock_port_sync();
+
+    const uint8_t inputs = g_mock_port_last_regs[MOCK_PORT_REG_PM6];
+
+    return (uint8_t)((g_mock_port_last_regs[MOCK_PORT_REG_P6] & ~inputs) | (g_mock_port_lines & inputs));
+}
+
+uint8_t MOCK_PORT_Lines(void)
+{
+    mock_port_sync();
+
+    return g_mock_port_lines;
+}
+
+void MOCK_PORT_HoldLow(uint8_t lines, uint8_t clocks)
+{
+    mock_port_sync();
+    g_mock_port_held = lines;
+    g_mock_port_hold_clocks = clocks;
+    mock_port_sync();
+}
+
+const mock_port_event_t *MOCK_PORT_GetEvents(uint32_t *count)
+{
+    mock_port_sync();
+
+    if (count != NULL)
+    {
+        *count = g_mock_port_event_count;
+    }
+
+    return g_mock_port_events;
+}
+
+uint32_t MOCK_PORT_CyclesToNs(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000000ULL) / MOCK_PORT_CPU_HZ);
+}
+
+static void mock_port_vcd_byte(FILE *stream, uint8_t value, char id)
+{
+    (void)fputc('b', stream);
+    for (uint8_t mask = UINT8_C(0x80); mask != 0U; mask >>= 1)
+    {
+        (void)fputc(((value & mask) != 0U) ? '1' : '0', stream);
+    }
+    (void)fprintf(stream, " %c\n", id);
+}
+
+bool MOCK_PORT_WriteVcd(FILE *stream)
+{
+    uint32_t count = 0U;
+    const mock_port_event_t *events = MOCK_PORT_GetEvents(&count);
+
+    if ((stream == NULL) || g_mock_port_overflow)
+    {
+        return false;
+    }
+
+    (void)fprintf(stream, "$timescale 1ns $end\n$scope module port6 $end\n");
+    (void)fprintf(stream, "$var wire 1 ! scl $end\n$var wire 1 \" sda $end\n");
+    for (uint8_t index = 0U; index < (uint8_t)MOCK_PORT_REG_COUNT; index++)
+    {
+        (void)fprintf(stream, "$var reg 8 %c %s $end\n", (char)('#' + index), g_mock_port_reg_names[index]);
+    }
+    (void)fprintf(stream, "$upscope $end\n$enddefinitions $end\n");
+
+    for (uint32_t index = 0U; index < count; index++)
+    {
+        const mock_port_event_t *event = &events[index];
+        const mock_port_event_t *previous = (index > 0U) ? &events[index - 1U] : NULL;
+
+        if ((previous == NULL) || (previous->cycle != event->cycle))
+        {
+            (void)fprintf(stream, "#%lu\n", (unsigned long)MOCK_PORT_CyclesToNs(event->cycle));
+        }
+        if ((previous == NULL) || (((previous->lines ^ event->lines) & MOCK_PORT_LINE_SCL) != 0U))
+        {
+            (void)fprintf(stream, "%c!\n", ((event->lines & MOCK_PORT_LINE_SCL) != 0U) ? '1' : '0');
+        }
+        if ((previous == NULL) || (((previous->lines ^ event->lines) & MOCK_PORT_LINE_SDA) != 0U))
+        {
+            (void)fprintf(stream, "%c\"\n", ((event->lines & MOCK_PORT_LINE_SDA) != 0U) ? '1' : '0');
+        }
+        for (uint8_t reg = 0U; reg < (uint8_t)MOCK_PORT_REG_COUNT; reg++)
+        {
+            if ((previous == NULL) || (previous->regs[reg] != event->regs[reg]))
+            {
+                mock_port_vcd_byte(stream, event->regs[reg], (char)('#' + reg));
+            }
+        }
+    }
+
+    return (ferror(stream) == 0);
+}
@@ -0,0 +1,78 @@
+#ifndef MOCK_PORT_H
+#define MOCK_PORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Virtual P6 for the host build. The port registers are plain bytes so code
+ * can keep writing them directly and take their addresses; every call into
+ * this model first compares them with the last recorded state and logs any
+ * change at the current virtual time. Time only moves in MOCK_PORT_Elapse,
+ * which the busy-wait hooks of the drivers call, so a write is stamped with
+ * the cycle the driver reached when it made it; writes with no delay or port
+ * read in between land in one event. The bit-bang and bus recovery paths
+ * elapse zero cycles after each pin write, so every intermediate state of
+ * theirs gets its own event at the same time stamp.
+ *
+ * P60 (SDA) and P61 (SCL) are open-drain bus lines with external pull-ups:
+ * a line is low while its pin is an output latched low or while the modelled
+ * device holds it low. The log can be written out as a VCD file.
+ */
+#ifndef MOCK_PORT_CPU_HZ
+#define MOCK_PORT_CPU_HZ      (32000000UL)
+#endif
+
+#ifndef MOCK_PORT_MAX_EVENTS
+#define MOCK_PORT_MAX_EVENTS  (8192U)
+#endif
+
+#define MOCK_PORT_LINE_SDA    ((uint8_t)(1U << 0))
+#define MOCK_PORT_LINE_SCL    ((uint8_t)(1U << 1))
+
+typedef enum
+{
+    MOCK_PORT_REG_P6 = 0,
+    MOCK_PORT_REG_PM6,
+    MOCK_PORT_REG_PMC6,
+    MOCK_PORT_REG_PU6,
+    MOCK_PORT_REG_COUNT
+} mock_port_reg_t;
+
+/* State after a change: register contents and the resolved line levels */
+typedef struct
+{
+    uint32_t cycle;
+    uint8_t  regs[MOCK_PORT_REG_COUNT];
+    uint8_t  lines;
+} mock_port_event_t;
+
+extern volatile uint8_t g_mock_port_regs[MOCK_PORT_REG_COUNT];
+
+/* Reset values, cycle 0, empty log, no device holding a line. */
+void MOCK_PORT_Reset(void);
+
+void MOCK_PORT_Elapse(uint32_t cycles);
+uint32_t MOCK_PORT_Now(void);
+
+/* P6 as the CPU reads it: the latch for outputs, the line for inputs. */
+uint8_t MOCK_PORT_ReadP6(void);
+
+/* Resolved bus line levels, MOCK_PORT_LINE_* bits set while high. */
+uint8_t MOCK_PORT_Lines(void);
+
+/*
+ * A device holds lines low until SCL has risen clocks times; 0 holds them
+ * until the next MOCK_PORT_Reset.
+ */
+void MOCK_PORT_HoldLow(uint8_t lines, uint8_t clocks);
+
+const mock_port_event_t *MOCK_PORT_GetEvents(uint32_t *count);
+
+uint32_t MOCK_PORT_CyclesToNs(uint32_t cycles);
+
+/* Write the log as a VCD with a 1 ns timescale; scl, sda and the registers. */
+bool MOCK_PORT_WriteVcd(FILE *stream);
+
+#endif /* MOCK_PORT_H */
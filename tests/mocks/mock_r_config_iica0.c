@@ -1,7 +1,12 @@
 #include "r_config_iica0.h"
 #include "mock_r_config_iica0.h"
 
+#include <stddef.h>
+
 static mock_r_config_iica0_state_t g_state = {0};
+static uint8_t g_bus_lines = (uint8_t)(R_IICA0_LINE_SDA | R_IICA0_LINE_SCL);
+static const uint8_t *g_line_sequence = NULL;
+static uint8_t g_line_sequence_left = 0U;
 
 void MOCK_R_Config_IICA0_Reset(void)
 {
@@ -10,6 +15,21 @@ void MOCK_R_Config_IICA0_Reset(void)
     g_state.create_calls = 0U;
     g_state.start_calls = 0U;
     g_state.slave_receive_start_calls = 0U;
+    g_state.sample_bus_lines_calls = 0U;
+    g_state.reset_peripheral_calls = 0U;
+    g_bus_lines = (uint8_t)(R_IICA0_LINE_SDA | R_IICA0_LINE_SCL);
+    g_line_sequence_left = 0U;
+}
+
+void MOCK_R_Config_IICA0_SetBusLines(uint8_t lines)
+{
+    g_bus_lines = lines;
+}
+
+void MOCK_R_Config_IICA0_SetBusLineSequence(const uint8_t *levels, uint8_t count)
+{
+    g_line_sequence = levels;
+    g_line_sequence_left = (levels != NULL) ? count : 0U;
 }
 
 const mock_r_config_iica0_state_t *MOCK_R_Config_IICA0_GetState(void)
@@ -22,6 +42,22 @@ void R_Config_IICA0_ResetBusLines(void)
     g_state.reset_bus_lines_calls++;
 }
 
+uint8_t R_Config_IICA0_SampleBusLines(void)
+{
+    g_state.sample_bus_lines_calls++;
+    if (g_line_sequence_left > 0U)
+    {
+        g_line_sequence_left--;
+        return *g_line_sequence++;
+    }
+    return g_bus_lines;
+}
+
+void R_Config_IICA0_ResetPeripheral(void)
+{
+    g_state.reset_peripheral_calls++;
+}
+
 void R_Config_IICA0_Stop(void)
 {
     g_state.stop_calls++;
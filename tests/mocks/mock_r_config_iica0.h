@@ -10,9 +10,15 @@ typedef struct
     uint32_t create_calls;
     uint32_t start_calls;
     uint32_t slave_receive_start_calls;
+    uint32_t sample_bus_lines_calls;
+    uint32_t reset_peripheral_calls;
 } mock_r_config_iica0_state_t;
 
 void MOCK_R_Config_IICA0_Reset(void);
+/* Levels returned by R_Config_IICA0_SampleBusLines; idle after Reset */
+void MOCK_R_Config_IICA0_SetBusLines(uint8_t lines);
+/* The next count samples come from levels, then the SetBusLines value again */
+void MOCK_R_Config_IICA0_SetBusLineSequence(const uint8_t *levels, uint8_t count);
 const mock_r_config_iica0_state_t *MOCK_R_Config_IICA0_GetState(void);
 
 #endif /* MOCK_R_CONFIG_IICA0_H */
@@ -1,6 +0,0 @@
-#include "r_cg_macrodriver.h"
-
-volatile uint8_t P6 = 0xFFU;
-volatile uint8_t PM6 = 0xFFU;
-volatile uint8_t PMC6 = 0x00U;
-volatile uint8_t PU6 = 0x00U;
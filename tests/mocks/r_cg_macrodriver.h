@@ -1,12 +1,74 @@
 #ifndef R_CG_MACRODRIVER_H
 #define R_CG_MACRODRIVER_H
 
+#include "mock_port.h"
+
+#include <stdbool.h>
 #include <stdint.h>
 
-extern volatile uint8_t P6;
-extern volatile uint8_t PM6;
-extern volatile uint8_t PMC6;
-extern volatile uint8_t PU6;
+/* Single-threaded host build: hal_critical.h masks nothing */
+#ifndef HAL_HOST_TEST
+#define HAL_HOST_TEST  (1)
+#endif
+
+/*
+ * Port 6 lives in the virtual port of mock_port.c. Busy-wait loops advance
+ * its clock and input reads see the modelled bus lines, so bit-banged timing
+ * can be measured and dumped as a waveform.
+ */
+#define P6    (g_mock_port_regs[MOCK_PORT_REG_P6])
+#define PM6   (g_mock_port_regs[MOCK_PORT_REG_PM6])
+#define PMC6  (g_mock_port_regs[MOCK_PORT_REG_PMC6])
+#define PU6   (g_mock_port_regs[MOCK_PORT_REG_PU6])
+
+#define HAL_I2C_MASTER_ELAPSE(cycles)  MOCK_PORT_Elapse((uint32_t)(cycles))
+#define HAL_I2C_MASTER_READ_PORT()     MOCK_PORT_ReadP6()
+#define R_IICA0_ELAPSE(cycles)         MOCK_PORT_Elapse((uint32_t)(cycles))
+#define R_IICA0_READ_PORT()            MOCK_PORT_ReadP6()
+
+/* TAU0 channel 0, the scheduler tick timer; set by the scheduler tests */
+extern volatile uint16_t g_mock_tcr00;
+extern volatile uint16_t g_mock_tdr00;
+extern volatile uint8_t  g_mock_tmif00;
+
+#define TCR00   (g_mock_tcr00)
+#define TDR00   (g_mock_tdr00)
+#define TMIF00  (g_mock_tmif00)
+
+/*
+ * IICA1 SFRs are routed through the register model in mock_iica1.c so that
+ * start/stop requests take effect the way the peripheral would apply them.
+ */
+typedef enum
+{
+    MOCK_IICA1_REG_IICA = 0,
+    MOCK_IICA1_REG_IICS,
+    MOCK_IICA1_REG_IICF,
+    MOCK_IICA1_REG_IICCTL0,
+    MOCK_IICA1_REG_IICCTL1,
+    MOCK_IICA1_REG_IICWL,
+    MOCK_IICA1_REG_IICWH,
+    MOCK_IICA1_REG_SVA,
+    MOCK_IICA1_REG_COUNT
+} mock_iica1_reg_t;
+
+volatile uint8_t *MOCK_IICA1_Access(mock_iica1_reg_t reg);
+bool MOCK_IICA1_Service(void);
+
+#define IICA1     (*MOCK_IICA1_Access(MOCK_IICA1_REG_IICA))
+#define IICS1     (*MOCK_IICA1_Access(MOCK_IICA1_REG_IICS))
+#define IICF1     (*MOCK_IICA1_Access(MOCK_IICA1_REG_IICF))
+#define IICCTL10  (*MOCK_IICA1_Access(MOCK_IICA1_REG_IICCTL0))
+#define IICCTL11  (*MOCK_IICA1_Access(MOCK_IICA1_REG_IICCTL1))
+#define IICWL1    (*MOCK_IICA1_Access(MOCK_IICA1_REG_IICWL))
+#define IICWH1    (*MOCK_IICA1_Access(MOCK_IICA1_REG_IICWH))
+#define SVA1      (*MOCK_IICA1_Access(MOCK_IICA1_REG_SVA))
+
+extern volatile uint8_t IICAMK1;
+extern volatile uint8_t IICAIF1;
+
+/* While a blocking master call waits, let the modelled bus make progress */
+#define HAL_I2C_MASTER_WAIT_IDLE()  ((void)MOCK_IICA1_Service())
 
 static inline void R_Config_NOP(void)
 {
@@ -10,7 +10,13 @@
 #define R_IICA0_STATUS_LINE_STUCK       (1U << 4)
 #define R_IICA0_STATUS_FRAME_ERROR      (1U << 5)
 
+/* R_Config_IICA0_SampleBusLines result bits, set while the line is high */
+#define R_IICA0_LINE_SDA                (1U << 0)
+#define R_IICA0_LINE_SCL                (1U << 1)
+
 void R_Config_IICA0_ResetBusLines(void);
+uint8_t R_Config_IICA0_SampleBusLines(void);
+void R_Config_IICA0_ResetPeripheral(void);
 void R_Config_IICA0_Stop(void);
 void R_Config_IICA0_Create(void);
 void R_Config_IICA0_Start(void);